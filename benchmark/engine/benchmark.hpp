@@ -7,6 +7,8 @@
 #include "player.hpp"
 #include "cat.hpp"
 
+#include <inventory/archetype_registry.hpp>
+
 namespace ivnt_test
 {
 	/**
@@ -47,6 +49,41 @@ namespace ivnt_test
 			gameEngine.update();
 	}
 
+	/**
+	 * @brief Test function to test the archetype registry.
+	 * This creates the same entities as the engine tests, and runs the same queries as the engine update using the archetype registry.
+	 *
+	 * @param state The benchmark state.
+	 */
+	template <int ObjectCount>
+	inline void iteration_test_archetype(benchmark::State &state)
+	{
+		inventory::archetype_registry<engine::model_component, engine::camera_component, engine::position_component> registry;
+		for (int i = 0; i < ObjectCount; i++)
+		{
+			const auto p = registry.create_entity();
+			[[maybe_unused]] auto &pm = registry.register_to_system<engine::model_component>(p);
+			[[maybe_unused]] auto &pc = registry.register_to_system<engine::camera_component>(p);
+
+			const auto c = registry.create_entity();
+			[[maybe_unused]] auto &cm = registry.register_to_system<engine::model_component>(c);
+			[[maybe_unused]] auto &cc = registry.register_to_system<engine::camera_component>(c);
+			[[maybe_unused]] auto &cp = registry.register_to_system<engine::position_component>(c);
+		}
+
+		for (auto _ : state)
+		{
+			for (auto [ent, model, camera] : registry.each<engine::model_component, engine::camera_component>())
+			{
+				benchmark::DoNotOptimize(model);
+				benchmark::DoNotOptimize(camera);
+			}
+
+			for (auto [ent, position] : registry.each<engine::position_component>())
+				benchmark::DoNotOptimize(position);
+		}
+	}
+
 	/**
 	 * @brief Insertion test.
 	 * This will take the time taken by this implementation to insert 2 entities.
@@ -63,6 +100,25 @@ namespace ivnt_test
 		}
 	}
 
+	/**
+	 * @brief Bulk insertion test.
+	 * This will take the time taken by this implementation to insert 2 entities using the bulk creation and registration methods.
+	 *
+	 * @param state The state counter.
+	 */
+	inline void bulk_insertion_test(benchmark::State &state)
+	{
+		engine::engine gameEngine;
+		auto &registry = gameEngine.get_registry();
+		for (auto _ : state)
+		{
+			const auto entities = registry.create_entities(2);
+			registry.register_to_system<engine::model_component>(entities);
+			registry.register_to_system<engine::camera_component>(entities);
+			registry.register_to_system<engine::position_component>(std::span(entities).subspan(1));
+		}
+	}
+
 	/**
 	 * @brief Deletion test.
 	 * This will take the time taken by this implementation to delete 2 entities.
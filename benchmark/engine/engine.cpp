@@ -16,10 +16,10 @@ namespace engine
 
 	void engine::update()
 	{
-		for (auto &ent : m_Registry.query<model_component, camera_component>())
+		for (auto [ent, model, camera] : m_Registry.each<model_component, camera_component>())
 		{
-			update_component(m_Registry.get_component<model_component>(ent));
-			update_component(m_Registry.get_component<camera_component>(ent));
+			update_component(model);
+			update_component(camera);
 		}
 
 		for (auto &component : m_Registry.query<position_component>())
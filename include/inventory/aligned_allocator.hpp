@@ -0,0 +1,144 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace inventory
+{
+	/**
+	 * @brief Aligned allocator object.
+	 * This allocator wraps another allocator, and allocates memory in whole blocks of the alignment size. Every allocation starts on an alignment boundary, and its size is
+	 * padded to a whole number of blocks, so the allocation does not share its first or last block (usually a cache line) with any other allocation. The blocks are allocated
+	 * using the upstream allocator, which makes this usable with polymorphic allocators as well.
+	 *
+	 * Note that this class is not final, as standard containers may derive from their allocator.
+	 *
+	 * @tparam Type The value type.
+	 * @tparam Alignment The alignment of the allocations in bytes. This must be a power of two. Default is default_cache_line_size.
+	 * @tparam Upstream The upstream allocator type. Default is std::allocator<Type>.
+	 */
+	template <class Type, uint64_t Alignment = default_cache_line_size, class Upstream = std::allocator<Type>>
+	class aligned_allocator
+	{
+		static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "The alignment must be a power of two!");
+		static_assert(Alignment >= alignof(Type), "The alignment must not be smaller than the alignment of the type!");
+
+		template <class, uint64_t, class>
+		friend class aligned_allocator;
+
+		/**
+		 * @brief Block structure.
+		 * This is the unit which is allocated from the upstream allocator.
+		 */
+		struct alignas(Alignment) block final
+		{
+			std::byte m_Bytes[Alignment];
+		};
+
+		using block_allocator = typename std::allocator_traits<Upstream>::template rebind_alloc<block>;
+		using block_allocator_traits = std::allocator_traits<block_allocator>;
+
+		block_allocator m_Allocator = {};
+
+	public:
+		using value_type = Type;
+		using upstream_allocator_type = Upstream;
+		using propagate_on_container_copy_assignment = typename block_allocator_traits::propagate_on_container_copy_assignment;
+		using propagate_on_container_move_assignment = typename block_allocator_traits::propagate_on_container_move_assignment;
+		using propagate_on_container_swap = typename block_allocator_traits::propagate_on_container_swap;
+		using is_always_equal = typename block_allocator_traits::is_always_equal;
+
+		static constexpr uint64_t alignment = Alignment;
+
+		/**
+		 * @brief Rebind structure.
+		 * This is required as the default rebind does not work with the non-type alignment parameter.
+		 *
+		 * @tparam Other The other value type.
+		 */
+		template <class Other>
+		struct rebind final
+		{
+			using other = aligned_allocator<Other, Alignment, typename std::allocator_traits<Upstream>::template rebind_alloc<Other>>;
+		};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr aligned_allocator() = default;
+
+		/**
+		 * @brief Construct a new aligned allocator object.
+		 * This is intentionally implicit, so that containers using this allocator can be constructed using the upstream allocator.
+		 *
+		 * @param upstream The upstream allocator.
+		 */
+		constexpr aligned_allocator(const Upstream &upstream) : m_Allocator(upstream) {}
+
+		/**
+		 * @brief Construct a new aligned allocator object from an allocator of another value type.
+		 *
+		 * @tparam Other The other value type.
+		 * @tparam OtherUpstream The other upstream allocator type.
+		 * @param other The other allocator.
+		 */
+		template <class Other, class OtherUpstream>
+		constexpr aligned_allocator(const aligned_allocator<Other, Alignment, OtherUpstream> &other) : m_Allocator(other.m_Allocator) {}
+
+		/**
+		 * @brief Allocate memory for a number of elements.
+		 *
+		 * @param count The number of elements.
+		 * @return Type* The pointer to the first element. This is aligned to the alignment.
+		 */
+		INV_NODISCARD Type *allocate(const std::size_t count) { return reinterpret_cast<Type *>(std::to_address(block_allocator_traits::allocate(m_Allocator, get_block_count(count)))); }
+
+		/**
+		 * @brief Deallocate memory which was allocated using allocate().
+		 *
+		 * @param pointer The pointer to the first element.
+		 * @param count The number of elements which was allocated.
+		 */
+		void deallocate(Type *pointer, const std::size_t count) { block_allocator_traits::deallocate(m_Allocator, reinterpret_cast<block *>(pointer), get_block_count(count)); }
+
+		/**
+		 * @brief Get the allocator to use when a container is copied.
+		 *
+		 * @return aligned_allocator The allocator.
+		 */
+		INV_NODISCARD aligned_allocator select_on_container_copy_construction() const { return aligned_allocator(Upstream(block_allocator_traits::select_on_container_copy_construction(m_Allocator))); }
+
+		/**
+		 * @brief Get the upstream allocator.
+		 *
+		 * @return constexpr Upstream The upstream allocator.
+		 */
+		constexpr INV_NODISCARD Upstream upstream() const { return Upstream(m_Allocator); }
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @tparam Other The other value type.
+		 * @tparam OtherUpstream The other upstream allocator type.
+		 * @param other The other allocator.
+		 * @return true if memory allocated by one allocator can be deallocated by the other.
+		 * @return false if memory allocated by one allocator cannot be deallocated by the other.
+		 */
+		template <class Other, class OtherUpstream>
+		constexpr INV_NODISCARD bool operator==(const aligned_allocator<Other, Alignment, OtherUpstream> &other) const { return m_Allocator == other.m_Allocator; }
+
+	private:
+		/**
+		 * @brief Get the number of blocks required to store a number of elements.
+		 *
+		 * @param count The number of elements.
+		 * @return constexpr std::size_t The block count.
+		 */
+		static constexpr INV_NODISCARD std::size_t get_block_count(const std::size_t count) { return (count * sizeof(Type) + Alignment - 1) / Alignment; }
+	};
+} // namespace inventory
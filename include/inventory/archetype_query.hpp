@@ -0,0 +1,152 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "archetype_query_iterator.hpp"
+#include "parallel.hpp"
+
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Archetype query object.
+	 * This object holds the archetype tables which match a query, and is used to iterate over their rows. Since the components of a table are stored in contiguous
+	 * columns, the rows can also be processed a whole table at a time using for_each_table().
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Accessors The accessor tuple type.
+	 */
+	template <class Table, class Accessors>
+	class archetype_query final
+	{
+		using iterator = archetype_query_iterator<Table, Accessors>;
+
+		std::vector<Table *> m_Tables;
+
+		/**
+		 * @brief Get the chunk size which is aligned for all the selected components.
+		 *
+		 * @tparam Types The accessor types.
+		 * @param chunkSize The requested chunk size.
+		 * @return constexpr uint64_t The aligned chunk size.
+		 */
+		template <class... Types>
+		static constexpr INV_NODISCARD uint64_t get_aligned_chunk_size_of(const uint64_t chunkSize, std::tuple<Types...> *) { return get_aligned_chunk_size<typename Types::component_type...>(chunkSize); }
+
+	public:
+		/**
+		 * @brief Construct a new archetype query object.
+		 *
+		 * @param tables The matching tables.
+		 */
+		explicit archetype_query(std::vector<Table *> &&tables) : m_Tables(std::move(tables)) {}
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) begin() const { return iterator(m_Tables, 0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) end() const { return iterator(m_Tables, m_Tables.size()); }
+
+		/**
+		 * @brief Get the number of matching tables.
+		 *
+		 * @return constexpr uint64_t The table count.
+		 */
+		constexpr INV_NODISCARD uint64_t table_count() const noexcept { return m_Tables.size(); }
+
+		/**
+		 * @brief Call a function for every matching table.
+		 * The function is called with the span of entity indexes followed by the spans of the selected component columns. Optional components which are not stored in the
+		 * table are given as empty spans, and optional tags are given as a boolean which tells if the table has the tag.
+		 *
+		 * @tparam Function The function type.
+		 * @param function The function to call.
+		 */
+		template <class Function>
+		void for_each_table(Function &&function) const
+		{
+			for (auto pTable : m_Tables)
+			{
+				if (!pTable->empty())
+					[&function]<class... Types>(Table &table, std::tuple<Types...> *)
+					{ function(table.entities(), Types::column(table)...); }(*pTable, static_cast<Accessors *>(nullptr));
+			}
+		}
+
+		/**
+		 * @brief Get the rows of the matching tables in contiguous batches.
+		 * Every batch is a tuple containing the span of entity indexes followed by the spans of the selected component columns, and a batch never spans two tables.
+		 * The batch size is rounded up so that every batch starts on a cache line boundary relative to the first row of its table. Optional components which are not
+		 * stored in a table are given as empty spans, and optional tags are given as a boolean which tells if the table has the tag.
+		 *
+		 * @param chunkSize The number of rows in a single batch. Default is default_parallel_chunk_size.
+		 * @return decltype(auto) The vector of span tuples.
+		 */
+		INV_NODISCARD decltype(auto) chunks(const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			return []<class... Types>(const std::vector<Table *> &tables, const uint64_t size, std::tuple<Types...> *)
+			{
+				std::vector<std::tuple<std::span<const std::iter_value_t<decltype(std::declval<Table &>().entities().begin())>>, decltype(Types::column(std::declval<Table &>()))...>> batches;
+				for (auto pTable : tables)
+				{
+					for (uint64_t first = 0; first < pTable->size(); first += size)
+					{
+						const auto count = std::min(size, pTable->size() - first);
+						batches.emplace_back(pTable->entities().subspan(first, count), Types::column(*pTable, first, count)...);
+					}
+				}
+
+				return batches;
+			}(m_Tables, get_aligned_chunk_size_of(chunkSize, static_cast<Accessors *>(nullptr)), static_cast<Accessors *>(nullptr));
+		}
+
+		/**
+		 * @brief Call a function for every matching entity using an execution policy.
+		 * The rows of every table are split into chunks of a fixed size, and the chunks are processed using the policy. The function is called with the entity index
+		 * followed by the selected components, or only with the components if it does not accept the entity index. Entities and components must not be created or
+		 * destroyed while this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call.
+		 * @param chunkSize The number of entities processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			// Split every table separately, so that a chunk never spans two tables.
+			std::vector<std::pair<Table *, uint64_t>> chunks;
+			for (auto pTable : m_Tables)
+			{
+				for (uint64_t first = 0; first < pTable->size(); first += chunkSize)
+					chunks.emplace_back(pTable, first);
+			}
+
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), chunks.size(), 1, [&chunks, chunkSize, &function](const uint64_t chunk, const uint64_t)
+						   {
+							   const auto [pTable, first] = chunks[chunk];
+							   const auto last = std::min(first + chunkSize, pTable->size());
+							   const auto entities = pTable->entities();
+
+							   Accessors accessors;
+							   std::apply([pTable](auto &...accessor)
+										  { (accessor.bind(*pTable), ...); },
+										  accessors);
+
+							   for (auto row = first; row < last; row++)
+								   std::apply([&function, index = entities[row], row](const auto &...accessor)
+											  { invoke_with_entity(function, index, accessor.fetch(row)...); },
+											  accessors); });
+		}
+	};
+} // namespace inventory
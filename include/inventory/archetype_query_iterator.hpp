@@ -0,0 +1,285 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "component_traits.hpp"
+#include "platform.hpp"
+
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Archetype column accessor.
+	 * This is used by the archetype query iterator to fetch a component which is known to be present in the current table.
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Component The component type.
+	 */
+	template <class Table, class Component>
+	class archetype_column_accessor final
+	{
+		using pointer = std::conditional_t<std::is_const_v<Table>, const Component *, Component *>;
+
+		pointer m_pColumn = nullptr;
+
+	public:
+		using component_type = Component;
+
+		/**
+		 * @brief Bind the accessor to the column of a table.
+		 *
+		 * @param table The table.
+		 */
+		constexpr void bind(Table &table) { m_pColumn = table.template column<Component>().data(); }
+
+		/**
+		 * @brief Get the column of a table.
+		 *
+		 * @param table The table.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		static constexpr INV_NODISCARD decltype(auto) column(Table &table) { return table.template column<Component>(); }
+
+		/**
+		 * @brief Get a part of the column of a table.
+		 *
+		 * @param table The table.
+		 * @param first The first row.
+		 * @param count The number of rows.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		static constexpr INV_NODISCARD decltype(auto) column(Table &table, const uint64_t first, const uint64_t count) { return column(table).subspan(first, count); }
+
+		/**
+		 * @brief Fetch the component of a row of the bound table.
+		 *
+		 * @param row The row.
+		 * @return constexpr decltype(auto) The component reference.
+		 */
+		constexpr INV_NODISCARD decltype(auto) fetch(const uint64_t row) const { return m_pColumn[row]; }
+	};
+
+	/**
+	 * @brief Archetype optional column accessor.
+	 * This is used by the archetype query iterator to fetch a component which may not be present in the current table.
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Component The component type.
+	 */
+	template <class Table, class Component>
+	class archetype_optional_accessor final
+	{
+		using pointer = std::conditional_t<std::is_const_v<Table>, const Component *, Component *>;
+
+		pointer m_pColumn = nullptr;
+
+	public:
+		using component_type = Component;
+
+		/**
+		 * @brief Bind the accessor to the column of a table.
+		 *
+		 * @param table The table.
+		 */
+		constexpr void bind(Table &table) { m_pColumn = table.template has<Component>() ? table.template column<Component>().data() : nullptr; }
+
+		/**
+		 * @brief Get the column of a table.
+		 *
+		 * @param table The table.
+		 * @return constexpr decltype(auto) The column span. This is empty if the table does not store the component.
+		 */
+		static constexpr INV_NODISCARD decltype(auto) column(Table &table) { return table.template column<Component>(); }
+
+		/**
+		 * @brief Get a part of the column of a table.
+		 *
+		 * @param table The table.
+		 * @param first The first row.
+		 * @param count The number of rows.
+		 * @return constexpr decltype(auto) The column span. This is empty if the table does not store the component.
+		 */
+		static constexpr INV_NODISCARD decltype(auto) column(Table &table, const uint64_t first, const uint64_t count)
+		{
+			const auto span = column(table);
+			return span.empty() ? span : span.subspan(first, count);
+		}
+
+		/**
+		 * @brief Fetch the component of a row of the bound table.
+		 *
+		 * @param row The row.
+		 * @return constexpr pointer The component pointer. This will be nullptr if the table does not store the component.
+		 */
+		constexpr INV_NODISCARD pointer fetch(const uint64_t row) const { return m_pColumn ? m_pColumn + row : nullptr; }
+	};
+
+	/**
+	 * @brief Archetype optional column accessor.
+	 * This is used by the archetype query iterator to check if a tag is present in the current table. Tags are only stored in the mask of a table, so the presence is
+	 * cached once per table and yielded as a boolean, the same way as the optional tags of the basic registry.
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Component The tag type.
+	 */
+	template <class Table, class Component>
+		requires tag_component<Component>
+	class archetype_optional_accessor<Table, Component> final
+	{
+		bool m_IsPresent = false;
+
+	public:
+		using component_type = Component;
+
+		/**
+		 * @brief Bind the accessor to a table.
+		 *
+		 * @param table The table.
+		 */
+		constexpr void bind(Table &table) { m_IsPresent = table.template has<Component>(); }
+
+		/**
+		 * @brief Check if a table stores the tag.
+		 *
+		 * @param table The table.
+		 * @return true if the table stores the tag.
+		 * @return false if the table does not store the tag.
+		 */
+		static constexpr INV_NODISCARD bool column(Table &table) { return table.template has<Component>(); }
+
+		/**
+		 * @brief Check if a table stores the tag.
+		 * Every row of a table has the same tags, so this is the same for every part of the table.
+		 *
+		 * @param table The table.
+		 * @return true if the table stores the tag.
+		 * @return false if the table does not store the tag.
+		 */
+		static constexpr INV_NODISCARD bool column(Table &table, const uint64_t, const uint64_t) { return column(table); }
+
+		/**
+		 * @brief Check if the bound table stores the tag.
+		 *
+		 * @return true if the tag is present.
+		 * @return false if the tag is not present.
+		 */
+		constexpr INV_NODISCARD bool fetch(const uint64_t) const { return m_IsPresent; }
+	};
+
+	/**
+	 * @brief Archetype query iterator class.
+	 * This iterator walks the rows of a list of archetype tables, and yields a tuple containing the entity index followed by the selected components. The column
+	 * pointers are bound once per table, so every step within a table is a plain array access.
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Accessors The accessor tuple type.
+	 */
+	template <class Table, class Accessors>
+	class archetype_query_iterator;
+
+	/**
+	 * @brief Archetype query iterator class.
+	 * This iterator walks the rows of a list of archetype tables, and yields a tuple containing the entity index followed by the selected components. The column
+	 * pointers are bound once per table, so every step within a table is a plain array access.
+	 *
+	 * @tparam Table The table type. This can be const qualified.
+	 * @tparam Accessors The accessor types.
+	 */
+	template <class Table, class... Accessors>
+	class archetype_query_iterator<Table, std::tuple<Accessors...>> final
+	{
+		std::span<Table *const> m_Tables;
+		uint64_t m_Table = 0;
+		uint64_t m_Row = 0;
+		std::tuple<Accessors...> m_Accessors;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using entity_index_type = std::iter_value_t<decltype(std::declval<Table &>().entities().begin())>;
+		using value_type = std::tuple<entity_index_type, decltype(std::declval<const Accessors &>().fetch(0))...>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr archetype_query_iterator() = default;
+
+		/**
+		 * @brief Construct a new archetype query iterator object.
+		 *
+		 * @param tables The tables to iterate.
+		 * @param table The position of the first table.
+		 */
+		constexpr explicit archetype_query_iterator(std::span<Table *const> tables, const uint64_t table) : m_Tables(tables), m_Table(table) { skip_empty_tables(); }
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity index and the component references.
+		 */
+		constexpr INV_NODISCARD reference operator*() const
+		{
+			return std::apply([this](const auto &...accessors)
+							  { return reference(m_Tables[m_Table]->entities()[m_Row], accessors.fetch(m_Row)...); },
+							  m_Accessors);
+		}
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr archetype_query_iterator& The iterator reference.
+		 */
+		constexpr archetype_query_iterator &operator++()
+		{
+			if (++m_Row == m_Tables[m_Table]->size())
+			{
+				m_Row = 0;
+				m_Table++;
+				skip_empty_tables();
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr archetype_query_iterator The previous iterator.
+		 */
+		constexpr archetype_query_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same row.
+		 * @return false if the iterators point to different rows.
+		 */
+		constexpr INV_NODISCARD bool operator==(const archetype_query_iterator &other) const { return m_Table == other.m_Table && m_Row == other.m_Row; }
+
+	private:
+		/**
+		 * @brief Skip to the first table which is not empty, and bind the accessors to it.
+		 */
+		constexpr void skip_empty_tables()
+		{
+			while (m_Table < m_Tables.size() && m_Tables[m_Table]->empty())
+				m_Table++;
+
+			if (m_Table < m_Tables.size())
+				std::apply([pTable = m_Tables[m_Table]](auto &...accessors)
+						   { (accessors.bind(*pTable), ...); },
+						   m_Accessors);
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,487 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "archetype_table.hpp"
+#include "archetype_query.hpp"
+#include "flat_map.hpp"
+#include "query_filter.hpp"
+#include "sparse_array.hpp"
+
+#include <cassert>
+#include <deque>
+#include <memory_resource>
+
+namespace inventory
+{
+	/**
+	 * @brief Basic archetype registry class.
+	 * This is an alternative to the basic registry which stores the entities in archetype tables, where every table holds the entities with the exact same set of
+	 * components (see archetype_table). Queries iterate the matching tables as fully contiguous columns, at the cost of moving all the components of an entity to
+	 * another table whenever a component is registered or unregistered.
+	 *
+	 * The registry exposes the same entity, component and iteration methods as the basic registry, so both layouts can be swapped and benchmarked against the same
+	 * code. The component storage policies are not used, as the columns are always contiguous. Callbacks, change tracking and groups are only available in the
+	 * basic registry.
+	 *
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Allocator The allocator type. This is rebound and passed down to every container in the registry, including all the tables.
+	 * @tparam Components The components to store in the registry.
+	 */
+	template <index_type EntityIndex, class Allocator, class... Components>
+	class basic_archetype_registry final
+	{
+		template <class Type>
+		using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+		/**
+		 * @brief Entity record structure.
+		 * This stores the table of an entity and the row of the entity in that table.
+		 */
+		struct entity_record final
+		{
+			uint32_t m_Table = 0;
+			EntityIndex m_Row = 0;
+		};
+
+	public:
+		using entity_index_type = EntityIndex;
+		using allocator_type = Allocator;
+		using table_type = archetype_table<EntityIndex, Allocator, Components...>;
+		using mask_type = typename table_type::mask_type;
+
+		using table_container = std::deque<table_type, rebind_allocator<table_type>>;
+		using table_map = flat_map<mask_type, uint32_t, rebind_allocator<std::pair<mask_type, uint32_t>>>;
+		using record_container = sparse_array<entity_record, EntityIndex, default_page_size, contiguous_storage, rebind_allocator<entity_record>>;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		basic_archetype_registry() : basic_archetype_registry(Allocator()) {}
+
+		/**
+		 * @brief Construct a new archetype registry object.
+		 * All the memory used by the registry (entity records, tables and the table lookup) will be allocated using the given allocator.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		explicit basic_archetype_registry(const Allocator &allocator)
+			: m_Tables(rebind_allocator<table_type>(allocator)),
+			  m_TableLookup(rebind_allocator<std::pair<mask_type, uint32_t>>(allocator)),
+			  m_Records(rebind_allocator<entity_record>(allocator))
+		{
+			// Entities without any components are stored in the first table.
+			get_table(mask_type());
+		}
+
+		/**
+		 * @brief Get the allocator used by the registry.
+		 *
+		 * @return allocator_type The allocator.
+		 */
+		INV_NODISCARD allocator_type get_allocator() const { return allocator_type(m_Records.get_allocator()); }
+
+		/**
+		 * @brief Create a entity object.
+		 *
+		 * @return constexpr entity_index_type The entity index.
+		 */
+		constexpr INV_NODISCARD entity_index_type create_entity()
+		{
+			const auto index = m_Records.emplace().first;
+			m_Records[index].m_Row = m_Tables.front().push_entity(index);
+
+			return index;
+		}
+
+		/**
+		 * @brief Create multiple entities at once.
+		 * This will reserve the required space once, rather than growing the entity storage for each entity.
+		 *
+		 * @param count The number of entities to create.
+		 * @return std::vector<entity_index_type> The created entity indexes.
+		 */
+		INV_NODISCARD std::vector<entity_index_type> create_entities(const uint64_t count)
+		{
+			std::vector<entity_index_type> indexes;
+			indexes.reserve(count);
+			reserve_entities(m_Records.size() + count);
+
+			for (uint64_t i = 0; i < count; i++)
+				indexes.emplace_back(create_entity());
+
+			return indexes;
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of entities without reallocating.
+		 *
+		 * @param count The number of entities.
+		 */
+		constexpr void reserve_entities(const uint64_t count)
+		{
+			m_Records.reserve(count);
+			m_Tables.front().reserve(count);
+		}
+
+		/**
+		 * @brief Destroy an entity from the registry.
+		 * This will remove all the components of the entity.
+		 *
+		 * @param index The entity index.
+		 */
+		constexpr void destroy_entity(const entity_index_type index)
+		{
+			remove_row(m_Records[index]);
+			m_Records.remove(index);
+		}
+
+		/**
+		 * @brief Get the number of entities in the registry.
+		 *
+		 * @return constexpr uint64_t The entity count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Records.size(); }
+
+		/**
+		 * @brief Get the number of archetype tables in the registry.
+		 * Tables are created the first time an entity reaches a set of components, and are kept after they become empty.
+		 *
+		 * @return constexpr uint64_t The table count.
+		 */
+		constexpr INV_NODISCARD uint64_t table_count() const noexcept { return m_Tables.size(); }
+
+		/**
+		 * @brief Check if an entity is registered to a component.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return true if the entity has the component.
+		 * @return false if the entity does not have the component.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD bool is_registered_to(const entity_index_type index) const { return m_Tables[m_Records[index].m_Table].template has<Component>(); }
+
+		/**
+		 * @brief Register an entity to a component.
+		 * This moves all the components of the entity to the table which also has the new component. If the entity already has the component, the component is
+		 * replaced. If the constructor of the component throws, the entity is left unchanged.
+		 *
+		 * @tparam Component The component to register to.
+		 * @tparam Types The argument types.
+		 * @param index The entity index.
+		 * @param arguments The arguments to be forwarded to create the component.
+		 * @return constexpr decltype(auto) The created component reference. Tags are returned by value.
+		 */
+		template <class Component, class... Types>
+		constexpr INV_NODISCARD decltype(auto) register_to_system(const entity_index_type index, Types &&...arguments)
+		{
+			auto &record = m_Records[index];
+			if (m_Tables[record.m_Table].template has<Component>())
+			{
+				if constexpr (tag_component<Component>)
+					return Component(std::forward<Types>(arguments)...);
+
+				else
+					return m_Tables[record.m_Table].template column<Component>()[record.m_Row] = Component(std::forward<Types>(arguments)...);
+			}
+
+			// The component is created before the row is moved, so that a throwing constructor leaves the entity in its old table.
+			const auto target = get_transition<Component>(record.m_Table, true);
+			if constexpr (tag_component<Component>)
+			{
+				auto component = Component(std::forward<Types>(arguments)...);
+				move_row(record, target);
+
+				return component;
+			}
+
+			else
+			{
+				m_Tables[target].template emplace<Component>(std::forward<Types>(arguments)...);
+				move_row(record, target);
+
+				return m_Tables[target].template column<Component>()[record.m_Row];
+			}
+		}
+
+		/**
+		 * @brief Register multiple entities to a component.
+		 * Every component is constructed using the same arguments.
+		 *
+		 * @tparam Component The component to register to.
+		 * @tparam Types The argument types.
+		 * @param indexes The entity indexes.
+		 * @param arguments The arguments used to create each of the components.
+		 */
+		template <class Component, class... Types>
+		void register_to_system(std::span<const entity_index_type> indexes, const Types &...arguments)
+		{
+			for (const auto index : indexes)
+				[[maybe_unused]] decltype(auto) component = register_to_system<Component>(index, arguments...);
+		}
+
+		/**
+		 * @brief Unregister an entity from a component.
+		 * This moves the rest of the components of the entity to the table which does not have the component.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 */
+		template <class Component>
+		constexpr void unregister_from_system(const entity_index_type index)
+		{
+			auto &record = m_Records[index];
+			if (m_Tables[record.m_Table].template has<Component>())
+				move_row(record, get_transition<Component>(record.m_Table, false));
+		}
+
+		/**
+		 * @brief Get a component of an entity.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr Component& The component reference.
+		 */
+		template <class Component>
+			requires(!tag_component<Component>)
+		constexpr INV_NODISCARD Component &get_component(const entity_index_type index)
+		{
+			assert((is_registered_to<Component>(index) && "This entity is not registered to this component!"));
+
+			const auto &record = m_Records[index];
+			return m_Tables[record.m_Table].template column<Component>()[record.m_Row];
+		}
+
+		/**
+		 * @brief Get a component of an entity.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr const Component& The component reference.
+		 */
+		template <class Component>
+			requires(!tag_component<Component>)
+		constexpr INV_NODISCARD const Component &get_component(const entity_index_type index) const
+		{
+			assert((is_registered_to<Component>(index) && "This entity is not registered to this component!"));
+
+			const auto &record = m_Records[index];
+			return m_Tables[record.m_Table].template column<Component>()[record.m_Row];
+		}
+
+		/**
+		 * @brief Try and get a component of an entity.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr Component* The component pointer. This will be nullptr if the entity is not registered to the component.
+		 */
+		template <class Component>
+			requires(!tag_component<Component>)
+		constexpr INV_NODISCARD Component *try_get_component(const entity_index_type index) { return is_registered_to<Component>(index) ? &get_component<Component>(index) : nullptr; }
+
+		/**
+		 * @brief Try and get a component of an entity.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr const Component* The component pointer. This will be nullptr if the entity is not registered to the component.
+		 */
+		template <class Component>
+			requires(!tag_component<Component>)
+		constexpr INV_NODISCARD const Component *try_get_component(const entity_index_type index) const { return is_registered_to<Component>(index) ? &get_component<Component>(index) : nullptr; }
+
+		/**
+		 * @brief Query the entities which have the selected components.
+		 * This yields a tuple containing the entity index followed by the selected components, the same way as registry::each(). The selection may contain tags
+		 * and the exclude and optional filters. The query holds the tables which match when it is created; the tables are never moved, so the query stays valid when
+		 * new tables are created, but it does not include them.
+		 *
+		 * @tparam Selection The selected components and filters.
+		 * @return decltype(auto) The archetype query.
+		 */
+		template <class... Selection>
+		INV_NODISCARD decltype(auto) each() { return create_query<table_type, Selection...>(*this); }
+
+		/**
+		 * @brief Query the entities which have the selected components.
+		 * This yields a tuple containing the entity index followed by the selected components, the same way as registry::each(). The selection may contain tags
+		 * and the exclude and optional filters. The query holds the tables which match when it is created; the tables are never moved, so the query stays valid when
+		 * new tables are created, but it does not include them.
+		 *
+		 * @tparam Selection The selected components and filters.
+		 * @return decltype(auto) The archetype query.
+		 */
+		template <class... Selection>
+		INV_NODISCARD decltype(auto) each() const { return create_query<const table_type, Selection...>(*this); }
+
+	private:
+		/**
+		 * @brief Create a query over the tables which match the selected components.
+		 *
+		 * @tparam Table The table type. This can be const qualified.
+		 * @tparam Selection The selected components and filters.
+		 * @tparam Self The registry type. This can be const qualified.
+		 * @param self The registry.
+		 * @return decltype(auto) The archetype query.
+		 */
+		template <class Table, class... Selection, class Self>
+		static INV_NODISCARD decltype(auto) create_query(Self &self)
+		{
+			static_assert(!(change_filter<Selection> || ...), "The added and changed filters are not supported by the archetype registry!");
+
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			std::vector<Table *> tables;
+			for (auto &table : self.m_Tables)
+			{
+				if (table.mask().contains(required) && !table.mask().intersects(excluded))
+					tables.emplace_back(&table);
+			}
+
+			using accessors = decltype(std::tuple_cat(create_accessors<Table, Selection>()...));
+			return archetype_query<Table, accessors>(std::move(tables));
+		}
+
+		/**
+		 * @brief Add a selected type of a query to the required and excluded masks.
+		 *
+		 * @tparam Type The selected type.
+		 * @param required The required mask.
+		 * @param excluded The excluded mask.
+		 */
+		template <class Type>
+		static constexpr void add_to_query_masks(mask_type &required, mask_type &excluded)
+		{
+			if constexpr (is_exclude_filter<Type>::value)
+				[]<class... Excluded>(mask_type &mask, exclude<Excluded...>)
+				{ (mask.toggle_true(get_component_index<Excluded, Components...>()), ...); }(excluded, Type());
+
+			else if constexpr (!is_optional_filter<Type>::value)
+				required.toggle_true(get_component_index<Type, Components...>());
+		}
+
+		/**
+		 * @brief Create the column accessors of a selected type of a query.
+		 * Tags and excluded components does not create any accessors as they are only used to filter.
+		 *
+		 * @tparam Table The table type. This can be const qualified.
+		 * @tparam Type The selected type.
+		 * @return constexpr decltype(auto) The tuple of accessors.
+		 */
+		template <class Table, class Type>
+		static constexpr INV_NODISCARD decltype(auto) create_accessors()
+		{
+			if constexpr (is_optional_filter<Type>::value)
+				return []<class... Optional>(optional<Optional...>)
+				{ return std::tuple<archetype_optional_accessor<Table, Optional>...>(); }(Type());
+
+			else if constexpr (tag_component<Type> || is_exclude_filter<Type>::value)
+				return std::tuple<>();
+
+			else
+				return std::tuple<archetype_column_accessor<Table, Type>>();
+		}
+
+		/**
+		 * @brief Get the table which stores a given set of components, and create it if it does not exist.
+		 *
+		 * @param mask The mask of the components.
+		 * @return uint32_t The table index.
+		 */
+		uint32_t get_table(const mask_type &mask)
+		{
+			const auto itr = m_TableLookup.find(mask);
+			if (itr != m_TableLookup.end() && itr->first == mask)
+				return itr->second;
+
+			const auto table = static_cast<uint32_t>(m_Tables.size());
+			m_Tables.emplace_back(mask, get_allocator());
+			m_TableLookup[mask] = table;
+
+			return table;
+		}
+
+		/**
+		 * @brief Get the table which an entity moves to when a component is added or removed.
+		 *
+		 * @tparam Component The component type.
+		 * @param source The table the entity is currently in.
+		 * @param isAdded Whether the component is added or removed.
+		 * @return uint32_t The target table index.
+		 */
+		template <class Component>
+		uint32_t get_transition(const uint32_t source, const bool isAdded)
+		{
+			constexpr auto component = get_component_index<Component, Components...>();
+
+			auto target = m_Tables[source].get_transition(component, isAdded);
+			if (target == table_type::invalid_transition)
+			{
+				auto mask = m_Tables[source].mask();
+				mask.toggle(component, isAdded);
+
+				target = get_table(mask);
+				m_Tables[source].set_transition(component, isAdded, target);
+			}
+
+			return target;
+		}
+
+		/**
+		 * @brief Move the components of an entity to another table.
+		 *
+		 * @param record The entity record.
+		 * @param target The target table index.
+		 */
+		constexpr void move_row(entity_record &record, const uint32_t target)
+		{
+			auto &destination = m_Tables[target];
+			const auto row = static_cast<EntityIndex>(destination.size());
+
+			m_Tables[record.m_Table].move_row(record.m_Row, destination);
+			remove_row(record);
+
+			record.m_Table = target;
+			record.m_Row = row;
+		}
+
+		/**
+		 * @brief Remove the row of an entity from its table, and update the record of the entity which was moved to the row.
+		 *
+		 * @param record The entity record.
+		 */
+		constexpr void remove_row(const entity_record &record)
+		{
+			const auto moved = m_Tables[record.m_Table].remove_row(record.m_Row);
+			if (moved != invalid_index<EntityIndex>)
+				m_Records[moved].m_Row = record.m_Row;
+		}
+
+	private:
+		table_container m_Tables;
+		table_map m_TableLookup;
+		record_container m_Records;
+	};
+
+	/**
+	 * @brief Archetype registry type.
+	 * This type is a basic archetype registry which uses the default index type and the standard allocator.
+	 *
+	 * @tparam Components The components to store in the registry.
+	 */
+	template <class... Components>
+	using archetype_registry = basic_archetype_registry<default_index_type, std::allocator<std::byte>, Components...>;
+
+	/**
+	 * @brief Polymorphic memory resource archetype registry type.
+	 * This archetype registry allocates all of its memory from a std::pmr::memory_resource.
+	 *
+	 * @tparam Components The components.
+	 */
+	template <class... Components>
+	using pmr_archetype_registry = basic_archetype_registry<default_index_type, std::pmr::polymorphic_allocator<std::byte>, Components...>;
+} // namespace inventory
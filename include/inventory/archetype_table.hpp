@@ -0,0 +1,265 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "bit_set.hpp"
+#include "component_traits.hpp"
+
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Archetype table class.
+	 * An archetype table stores all the entities which have the exact same set of components. Every component of the table is stored in its own contiguous column, and
+	 * the components of a single entity are stored in the same row of all the columns. Tags are only stored in the mask of the table.
+	 *
+	 * The table also caches the tables which an entity moves to when a component is added or removed, so that the registry does not have to look them up again.
+	 *
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Allocator The allocator type. This is rebound for every column.
+	 * @tparam Components All the components of the registry.
+	 */
+	template <index_type EntityIndex, class Allocator, class... Components>
+	class archetype_table final
+	{
+		template <class Type>
+		using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+		template <class Component>
+		using column_type = std::vector<Component, rebind_allocator<Component>>;
+
+		using transition_array = std::array<uint32_t, get_component_count<Components...>()>;
+
+	public:
+		using mask_type = bit_set<get_component_count<Components...>()>;
+
+		/**
+		 * @brief The transition returned if the target table was not cached.
+		 */
+		static constexpr uint32_t invalid_transition = std::numeric_limits<uint32_t>::max();
+
+		/**
+		 * @brief Construct a new archetype table object.
+		 *
+		 * @param mask The mask of the components stored in the table.
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit archetype_table(const mask_type &mask, const Allocator &allocator)
+			: m_Mask(mask), m_Entities(rebind_allocator<EntityIndex>(allocator)), m_Columns(column_type<Components>(rebind_allocator<Components>(allocator))...)
+		{
+			m_AddTransitions.fill(invalid_transition);
+			m_RemoveTransitions.fill(invalid_transition);
+		}
+
+		/**
+		 * @brief Get the mask of the components stored in the table.
+		 *
+		 * @return constexpr const mask_type& The mask.
+		 */
+		constexpr INV_NODISCARD const mask_type &mask() const noexcept { return m_Mask; }
+
+		/**
+		 * @brief Get the number of entities (rows) in the table.
+		 *
+		 * @return constexpr uint64_t The entity count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Entities.size(); }
+
+		/**
+		 * @brief Check if the table is empty.
+		 *
+		 * @return true if there are no entities in the table.
+		 * @return false if there is at least one entity in the table.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return m_Entities.empty(); }
+
+		/**
+		 * @brief Get the entity indexes of the rows.
+		 *
+		 * @return constexpr std::span<const EntityIndex> The entity indexes.
+		 */
+		constexpr INV_NODISCARD std::span<const EntityIndex> entities() const noexcept { return m_Entities; }
+
+		/**
+		 * @brief Check if the table stores a component.
+		 *
+		 * @tparam Component The component type.
+		 * @return true if the component is in the mask of the table.
+		 * @return false if the component is not in the mask of the table.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD bool has() const { return m_Mask.test(get_component_index<Component, Components...>()); }
+
+		/**
+		 * @brief Get the column of a component.
+		 * The column is empty if the table does not store the component.
+		 *
+		 * @tparam Component The component type.
+		 * @return constexpr std::span<Component> The column.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD std::span<Component> column() noexcept { return std::get<column_type<Component>>(m_Columns); }
+
+		/**
+		 * @brief Get the column of a component.
+		 * The column is empty if the table does not store the component.
+		 *
+		 * @tparam Component The component type.
+		 * @return constexpr std::span<const Component> The column.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD std::span<const Component> column() const noexcept { return std::get<column_type<Component>>(m_Columns); }
+
+		/**
+		 * @brief Insert a new entity to the back of the table.
+		 * The components of the new row must be emplaced after this, using emplace() or by moving a row from another table.
+		 *
+		 * @param index The entity index.
+		 * @return constexpr EntityIndex The row of the entity.
+		 */
+		constexpr EntityIndex push_entity(const EntityIndex index)
+		{
+			m_Entities.emplace_back(index);
+			return static_cast<EntityIndex>(m_Entities.size() - 1);
+		}
+
+		/**
+		 * @brief Emplace a component to the back of its column.
+		 *
+		 * @tparam Component The component type.
+		 * @tparam Types The argument types.
+		 * @param arguments The arguments used to construct the component.
+		 * @return constexpr Component& The component reference.
+		 */
+		template <class Component, class... Types>
+		constexpr Component &emplace(Types &&...arguments) { return std::get<column_type<Component>>(m_Columns).emplace_back(std::forward<Types>(arguments)...); }
+
+		/**
+		 * @brief Move the components of a row to the back of another table.
+		 * Only the components which are stored in both the tables are moved, and the entity index is inserted to the other table. The row still needs to be removed from
+		 * this table using remove_row().
+		 *
+		 * @param row The row to move.
+		 * @param destination The destination table.
+		 */
+		constexpr void move_row(const EntityIndex row, archetype_table &destination)
+		{
+			destination.push_entity(m_Entities[row]);
+			(move_component<Components>(row, destination), ...);
+		}
+
+		/**
+		 * @brief Remove a row from the table.
+		 * The last row is moved to the removed row, which mirrors the swap-and-pop removal of the systems.
+		 *
+		 * @param row The row to remove.
+		 * @return constexpr EntityIndex The entity which was moved to the row. This is the removed entity if the row was the last row.
+		 */
+		constexpr EntityIndex remove_row(const EntityIndex row)
+		{
+			(remove_component<Components>(row), ...);
+
+			m_Entities[row] = m_Entities.back();
+			m_Entities.pop_back();
+
+			return row < m_Entities.size() ? m_Entities[row] : invalid_index<EntityIndex>;
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of rows without reallocating.
+		 *
+		 * @param count The number of rows.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			m_Entities.reserve(count);
+			(reserve_component<Components>(count), ...);
+		}
+
+		/**
+		 * @brief Get the cached table which an entity moves to when a component is added or removed.
+		 *
+		 * @param component The component index.
+		 * @param isAdded Whether the component is added or removed.
+		 * @return constexpr uint32_t The table index. This will be invalid_transition if it is not cached.
+		 */
+		constexpr INV_NODISCARD uint32_t get_transition(const uint64_t component, const bool isAdded) const { return isAdded ? m_AddTransitions[component] : m_RemoveTransitions[component]; }
+
+		/**
+		 * @brief Cache the table which an entity moves to when a component is added or removed.
+		 *
+		 * @param component The component index.
+		 * @param isAdded Whether the component is added or removed.
+		 * @param table The table index.
+		 */
+		constexpr void set_transition(const uint64_t component, const bool isAdded, const uint32_t table) { (isAdded ? m_AddTransitions : m_RemoveTransitions)[component] = table; }
+
+	private:
+		/**
+		 * @brief Move a single component of a row to the back of another table, if both the tables store it.
+		 *
+		 * @tparam Component The component type.
+		 * @param row The row to move.
+		 * @param destination The destination table.
+		 */
+		template <class Component>
+		constexpr void move_component(const EntityIndex row, archetype_table &destination)
+		{
+			if constexpr (!tag_component<Component>)
+			{
+				if (has<Component>() && destination.template has<Component>())
+					destination.template emplace<Component>(std::move(std::get<column_type<Component>>(m_Columns)[row]));
+			}
+		}
+
+		/**
+		 * @brief Remove a single component of a row, if the table stores it.
+		 *
+		 * @tparam Component The component type.
+		 * @param row The row to remove.
+		 */
+		template <class Component>
+		constexpr void remove_component(const EntityIndex row)
+		{
+			if constexpr (!tag_component<Component>)
+			{
+				if (has<Component>())
+				{
+					auto &column = std::get<column_type<Component>>(m_Columns);
+					if (row != column.size() - 1)
+						column[row] = std::move(column.back());
+
+					column.pop_back();
+				}
+			}
+		}
+
+		/**
+		 * @brief Reserve a single component column, if the table stores it.
+		 *
+		 * @tparam Component The component type.
+		 * @param count The number of rows.
+		 */
+		template <class Component>
+		constexpr void reserve_component(const uint64_t count)
+		{
+			if constexpr (!tag_component<Component>)
+			{
+				if (has<Component>())
+					std::get<column_type<Component>>(m_Columns).reserve(count);
+			}
+		}
+
+	private:
+		mask_type m_Mask;
+		std::vector<EntityIndex, rebind_allocator<EntityIndex>> m_Entities;
+		std::tuple<column_type<Components>...> m_Columns;
+
+		transition_array m_AddTransitions;
+		transition_array m_RemoveTransitions;
+	};
+} // namespace inventory
@@ -2,9 +2,13 @@
 
 #include "platform.hpp"
 #include <array>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 
-#ifdef INV_USE_UNSEQ
-#	include <execution>
+#if defined(INV_USE_AVX2) || defined(INV_USE_SSE2)
+#	include <immintrin.h>
 
 #endif
 
@@ -12,116 +16,56 @@ namespace inventory
 {
 	/**
 	 * @brief Bit set class.
-	 * This class is used to store a `Bits` number of bits. The main difference between this and the `std::bitset` is that, the `std::bitset` uses `bool`s to store
-	 * its values whereas this uses actual bits to store values.
+	 * This class is used to store a `Bits` number of bits. The main difference between this and the `std::bitset` is that this is fully constexpr, and provides the
+	 * mask operations (contains and intersects) which are needed by the queries. The bits are stored in 64 bit words, and masks which are larger than a single word
+	 * are compared using SIMD instructions when they are available (and when not evaluated at compile time).
 	 *
 	 * @tparam Bits The number of bits.
 	 */
 	template <uint64_t Bits>
 	class bit_set final
 	{
+	public:
+		using word_type = uint64_t;
+		static constexpr uint64_t word_bits = 64;
+		static constexpr uint64_t word_count = (Bits + word_bits - 1) / word_bits;
+
+	private:
 		/**
-		 * @brief Bit field structure.
-		 * This contains 1 byte worth of 8 bits which can be accessed seperately.
+		 * @brief Word comparison enum.
+		 * This specifies the comparison which is done between the words of two bit sets.
 		 */
-		struct bit_field
+		enum class comparison : uint8_t
 		{
-			union
-			{
-				struct
-				{
-					bool m_A : 1;
-					bool m_B : 1;
-					bool m_C : 1;
-					bool m_D : 1;
-					bool m_E : 1;
-					bool m_F : 1;
-					bool m_G : 1;
-					bool m_H : 1;
-				};
-
-				uint8_t m_Value; // This variable is there to sum up the bits in the bit field and to easily compare and do other operations.
-			};
-
-			/**
-			 * @brief Is equal to operator.
-			 *
-			 * @param other The other bit field.
-			 * @return true if this is equal to the other.
-			 * @return false if this is not equal to the other.
-			 */
-			constexpr INV_NODISCARD bool operator==(const bit_field other) const { return m_Value == other.m_Value; }
-
-			/**
-			 * @brief Is not equal to operator.
-			 *
-			 * @param other The other bit field.
-			 * @return true if this is not equal to the other.
-			 * @return false if this is equal to the other.
-			 */
-			constexpr INV_NODISCARD bool operator!=(const bit_field other) const { return m_Value != other.m_Value; }
-
-			/**
-			 * @brief Less than operator.
-			 *
-			 * @param other The other bit field to compare.
-			 * @return true if this is less than the other.
-			 * @return false if this is grater than or equal to the other.
-			 */
-			constexpr INV_NODISCARD bool operator<(const bit_field other) const { return m_Value < other.m_Value; }
-
-			/**
-			 * @brief Grater than or equal operator.
-			 *
-			 * @param other The other bit field to compare.
-			 * @return true if this is grater than or equal the other.
-			 * @return false if this is less than the other.
-			 */
-			constexpr INV_NODISCARD bool operator>=(const bit_field other) const { return m_Value >= other.m_Value; }
-
-			/**
-			 * @brief Bitwise and operator.
-			 *
-			 * @param other The other bit field.
-			 * @return constexpr uint8_t The bitwise AND value.
-			 */
-			constexpr INV_NODISCARD uint8_t operator&(const bit_field other) const { return m_Value & other.m_Value; }
+			equal,
+			contains,
+			disjoint
 		};
 
+	public:
 		/**
-		 * @brief Resolve the array size.
-		 *
-		 * @tparam size The user defined size.
-		 * @return constexpr uint64_t The array size to set.
+		 * @brief The position returned by find_first() if no bit is set.
 		 */
-		template <uint64_t size>
-		static consteval INV_NODISCARD uint64_t resolve_array_size()
-		{
-			if constexpr (size % 8 == 0)
-				return size / 8;
-			else
-				return (size / 8) + 1;
-		}
+		static constexpr uint64_t npos = Bits;
 
-	public:
 		/**
 		 * @brief Default constructor.
 		 */
 		constexpr bit_set() = default;
 
 		/**
-		 * @brief Get the size of the internal byte array.
+		 * @brief Get the size of the internal word array.
 		 *
 		 * @return constexpr uint64_t The size.
 		 */
-		constexpr INV_NODISCARD uint64_t size() const { return resolve_array_size<Bits>(); }
+		constexpr INV_NODISCARD uint64_t size() const { return word_count; }
 
 		/**
-		 * @brief Get the indexable capacity of the internal byte array.
+		 * @brief Get the indexable capacity of the internal word array.
 		 *
 		 * @return constexpr uint64_t The capacity.
 		 */
-		constexpr INV_NODISCARD uint64_t capacity() const { return m_Bytes.size() * 8; }
+		constexpr INV_NODISCARD uint64_t capacity() const { return word_count * word_bits; }
 
 		/**
 		 * @brief Test a given position to check if the bit value is 1 or 0.
@@ -130,102 +74,118 @@ namespace inventory
 		 * @return true if the bit is 1.
 		 * @return false if the bit is 0.
 		 */
-		constexpr INV_NODISCARD bool test(const uint64_t pos) const
-		{
-			const auto field = m_Bytes[pos / 8];
-			switch (pos % 8)
-			{
-			case 1:
-				return field.m_B;
-
-			case 2:
-				return field.m_C;
+		constexpr INV_NODISCARD bool test(const uint64_t pos) const { return (m_Words[pos / word_bits] >> (pos % word_bits)) & 1; }
 
-			case 3:
-				return field.m_D;
+		/**
+		 * @brief Toggle a bit to a given value.
+		 *
+		 * @param pos The bit position to toggle.
+		 * @param value The value to set.
+		 */
+		constexpr void toggle(const uint64_t pos, const bool value)
+		{
+			const auto mask = word_type(1) << (pos % word_bits);
+			auto &word = m_Words[pos / word_bits];
 
-			case 4:
-				return field.m_E;
+			word = (word & ~mask) | (static_cast<word_type>(-static_cast<int64_t>(value)) & mask);
+		}
 
-			case 5:
-				return field.m_F;
+		/**
+		 * @brief Toggle a bit to true.
+		 *
+		 * @param pos The bit position to toggle.
+		 */
+		constexpr void toggle_true(const uint64_t pos) { m_Words[pos / word_bits] |= word_type(1) << (pos % word_bits); }
 
-			case 6:
-				return field.m_G;
+		/**
+		 * @brief Toggle a bit to false.
+		 *
+		 * @param pos The bit position to toggle.
+		 */
+		constexpr void toggle_false(const uint64_t pos) { m_Words[pos / word_bits] &= ~(word_type(1) << (pos % word_bits)); }
 
-			case 7:
-				return field.m_H;
+		/**
+		 * @brief Get the number of bits which are set.
+		 *
+		 * @return constexpr uint64_t The bit count.
+		 */
+		constexpr INV_NODISCARD uint64_t count() const
+		{
+			uint64_t bitCount = 0;
+			for (const auto word : m_Words)
+				bitCount += std::popcount(word);
 
-			default:
-				return field.m_A;
-			}
+			return bitCount;
 		}
 
 		/**
-		 * @brief Toggle a bit to true.
+		 * @brief Find the position of the first bit which is set.
 		 *
-		 * @param pos The bit position to toggle.
-		 * @param value The value to set.
+		 * @return constexpr uint64_t The bit position. This will be npos if no bit is set.
 		 */
-		constexpr void toggle(const uint64_t pos, const bool value)
+		constexpr INV_NODISCARD uint64_t find_first() const
 		{
-			const auto index = pos / 8;
-			switch (pos % 8)
+			for (uint64_t i = 0; i < word_count; i++)
 			{
-			case 1:
-				m_Bytes[index].m_B = value;
-				break;
-
-			case 2:
-				m_Bytes[index].m_C = value;
-				break;
-
-			case 3:
-				m_Bytes[index].m_D = value;
-				break;
+				if (m_Words[i] != 0)
+					return i * word_bits + std::countr_zero(m_Words[i]);
+			}
 
-			case 4:
-				m_Bytes[index].m_E = value;
-				break;
+			return npos;
+		}
 
-			case 5:
-				m_Bytes[index].m_F = value;
-				break;
+		/**
+		 * @brief Find the position of the next bit which is set after a given position.
+		 *
+		 * @param pos The position to start searching after.
+		 * @return constexpr uint64_t The bit position. This will be npos if no bit is set.
+		 */
+		constexpr INV_NODISCARD uint64_t find_next(const uint64_t pos) const
+		{
+			const auto next = pos + 1;
+			if (next >= Bits)
+				return npos;
 
-			case 6:
-				m_Bytes[index].m_G = value;
-				break;
+			auto index = next / word_bits;
+			auto word = m_Words[index] & (~word_type(0) << (next % word_bits));
 
-			case 7:
-				m_Bytes[index].m_H = value;
-				break;
+			while (word == 0)
+			{
+				if (++index == word_count)
+					return npos;
 
-			default:
-				m_Bytes[index].m_A = value;
-				break;
+				word = m_Words[index];
 			}
+
+			return index * word_bits + std::countr_zero(word);
 		}
 
 		/**
-		 * @brief Toggle a bit to true.
+		 * @brief Check if any bit is set.
 		 *
-		 * @param pos The bit position to toggle.
+		 * @return true if at least one bit is set.
+		 * @return false if no bit is set.
 		 */
-		constexpr void toggle_true(const uint64_t pos) { toggle(pos, true); }
+		constexpr INV_NODISCARD bool any() const
+		{
+			return std::any_of(m_Words.begin(), m_Words.end(), [](const auto word)
+							   { return word != 0; });
+		}
 
 		/**
-		 * @brief Toggle a bit to false.
+		 * @brief Check if no bit is set.
 		 *
-		 * @param pos The bit position to toggle.
+		 * @return true if no bit is set.
+		 * @return false if at least one bit is set.
 		 */
-		constexpr void toggle_false(const uint64_t pos) { toggle(pos, true); }
+		constexpr INV_NODISCARD bool none() const { return !any(); }
 
 		/**
 		 * @brief Get the container that's actually holding the data.
 		 *
-		 * @return constexpr decltype(auto) The container.
+		 * @return constexpr const std::array<word_type, word_count>& The container.
 		 */
-		constexpr INV_NODISCARD decltype(auto) container() const { return m_Bytes; }
+		constexpr INV_NODISCARD const std::array<word_type, word_count> &container() const { return m_Words; }
 
 		/**
 		 * @brief Index a single bit using the position of it.
@@ -236,6 +196,15 @@ namespace inventory
 		 */
 		constexpr INV_NODISCARD bool operator[](const uint64_t pos) const { return test(pos); }
 
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other bit set.
+		 * @return true if this bit set is equal to the other.
+		 * @return false if this bit set is not equal to the other.
+		 */
+		constexpr INV_NODISCARD bool operator==(const bit_set &other) const { return compare<comparison::equal>(other); }
+
 		/**
 		 * @brief Not equal to operator.
 		 *
@@ -243,82 +212,162 @@ namespace inventory
 		 * @return true if this bit set is not equal to the other.
 		 * @return false if this bit set is equal to the other.
 		 */
-		constexpr INV_NODISCARD bool operator!=(const bit_set other) const
-		{
-#ifdef INV_USE_UNSEQ
-			return std::equal(std::execution::unseq, m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							  { return lhs != rhs; });
-
-#else
-			return std::equal(m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							  { return lhs != rhs; });
-
-#endif
-		}
+		constexpr INV_NODISCARD bool operator!=(const bit_set &other) const { return !(*this == other); }
 
 		/**
 		 * @brief Less than operator.
+		 * This performs a lexicographical comparison of the words, which makes bit sets usable as ordered keys.
 		 *
 		 * @param other The other bit set.
 		 * @return true if this bit set is less than the other.
 		 * @return false if this bit set is grater than or equal to the other.
 		 */
-		constexpr INV_NODISCARD bool operator<(const bit_set other) const
-		{
-#ifdef INV_USE_UNSEQ
-			return std::equal(std::execution::unseq, m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							  { return lhs < rhs; });
-
-#else
-			return std::equal(m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							  { return lhs < rhs; });
-
-#endif
-		}
+		constexpr INV_NODISCARD bool operator<(const bit_set &other) const { return std::lexicographical_compare(m_Words.begin(), m_Words.end(), other.m_Words.begin(), other.m_Words.end()); }
 
 		/**
 		 * @brief Logical AND operator.
-		 * This will internally perform a bitwise AND to all the bytes stored.
+		 * This is the same as contains().
+		 *
+		 * @param other The other bit set.
+		 * @return true if all the bits of the other are present.
+		 * @return false if at least one of the bits of the other are not present.
+		 */
+		constexpr INV_NODISCARD bool operator&&(const bit_set &other) const { return contains(other); }
+
+		/**
+		 * @brief Logical OR operator.
+		 * This is the same as intersects().
 		 *
 		 * @param other The other bit set.
-		 * @return true if all the bits are present.
+		 * @return true if there is at least one bit in common.
 		 * @return false if there are no bits in common.
 		 */
-		constexpr INV_NODISCARD bool operator&&(const bit_set other) const
-		{
-#ifdef INV_USE_UNSEQ
-			return !std::equal(std::execution::unseq, m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							   { return !((lhs & rhs) == rhs.m_Value); });
+		constexpr INV_NODISCARD bool operator||(const bit_set &other) const { return intersects(other); }
 
-#else
-			return !std::equal(m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							   { return !((lhs & rhs) == rhs.m_Value); });
+		/**
+		 * @brief Check if all the bits set in the other bit set are set in this.
+		 *
+		 * @param other The other bit set.
+		 * @return true if all the bits of the other are present.
+		 * @return false if at least one of the bits of the other are not present.
+		 */
+		constexpr INV_NODISCARD bool contains(const bit_set &other) const
+		{
+			if constexpr (word_count == 1)
+				return (m_Words[0] & other.m_Words[0]) == other.m_Words[0];
 
-#endif
+			else
+			{
+				return compare<comparison::contains>(other);
+			}
 		}
 
 		/**
-		 * @brief Logical OR operator.
-		 * This will internally perform a bitwise AND to all the bytes stored.
+		 * @brief Check if this and the other bit set has at least one bit in common.
 		 *
 		 * @param other The other bit set.
 		 * @return true if there is at least one bit in common.
 		 * @return false if there are no bits in common.
 		 */
-		constexpr INV_NODISCARD bool operator||(const bit_set other) const
+		constexpr INV_NODISCARD bool intersects(const bit_set &other) const
+		{
+			if constexpr (word_count == 1)
+				return (m_Words[0] & other.m_Words[0]) != 0;
+
+			else
+			{
+				return !compare<comparison::disjoint>(other);
+			}
+		}
+
+	private:
+		/**
+		 * @brief Check if a comparison is true for all the word pairs of this and another bit set.
+		 * Every comparison is reduced to a word which should be zero, so the leading words can be checked using SIMD instructions at runtime.
+		 *
+		 * @tparam Comparison The comparison to perform.
+		 * @param other The other bit set.
+		 * @return true if the comparison is true for all the words.
+		 * @return false if the comparison is false for at least one word.
+		 */
+		template <comparison Comparison>
+		constexpr INV_NODISCARD bool compare(const bit_set &other) const
 		{
-#ifdef INV_USE_UNSEQ
-			return !std::equal(std::execution::unseq, m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							   { return !((lhs & rhs) > 0); });
+			uint64_t i = 0;
+
+#if defined(INV_USE_AVX2) || defined(INV_USE_SSE2)
+			if (!std::is_constant_evaluated())
+			{
+
+#	ifdef INV_USE_AVX2
+				for (; i + 4 <= word_count; i += 4)
+				{
+					const auto lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_Words.data() + i));
+					const auto rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(other.m_Words.data() + i));
+
+					// Every operation is reduced to a vector which should be all zeros.
+					__m256i result;
+					if constexpr (Comparison == comparison::equal)
+						result = _mm256_xor_si256(lhs, rhs);
+
+					else if constexpr (Comparison == comparison::contains)
+						result = _mm256_andnot_si256(lhs, rhs);
+
+					else
+						result = _mm256_and_si256(lhs, rhs);
+
+					if (!_mm256_testz_si256(result, result))
+						return false;
+				}
 
-#else
-			return !std::equal(m_Bytes.begin(), m_Bytes.end(), other.m_Bytes.begin(), [](const auto lhs, const auto rhs)
-							   { return !((lhs & rhs) > 0); });
+#	endif
+
+#	ifdef INV_USE_SSE2
+				for (; i + 2 <= word_count; i += 2)
+				{
+					const auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_Words.data() + i));
+					const auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(other.m_Words.data() + i));
+
+					// Every operation is reduced to a vector which should be all zeros.
+					__m128i result;
+					if constexpr (Comparison == comparison::equal)
+						result = _mm_xor_si128(lhs, rhs);
+
+					else if constexpr (Comparison == comparison::contains)
+						result = _mm_andnot_si128(lhs, rhs);
+
+					else
+						result = _mm_and_si128(lhs, rhs);
+
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(result, _mm_setzero_si128())) != 0xFFFF)
+						return false;
+				}
+
+#	endif
+			}
 
 #endif
+
+			for (; i < word_count; i++)
+			{
+				word_type result;
+				if constexpr (Comparison == comparison::equal)
+					result = m_Words[i] ^ other.m_Words[i];
+
+				else if constexpr (Comparison == comparison::contains)
+					result = ~m_Words[i] & other.m_Words[i];
+
+				else
+					result = m_Words[i] & other.m_Words[i];
+
+				if (result != 0)
+					return false;
+			}
+
+			return true;
 		}
 
 	private:
-		std::array<bit_field, resolve_array_size<Bits>()> m_Bytes = {};
+		std::array<word_type, word_count> m_Words = {};
 	};
 } // namespace inventory
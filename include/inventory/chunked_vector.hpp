@@ -0,0 +1,551 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Chunked vector iterator.
+	 * This iterator walks a single chunk contiguously and jumps to the next chunk when it reaches the end of the current one.
+	 *
+	 * @tparam Type The value type. This could be const qualified for a const iterator.
+	 * @tparam ChunkSize The number of elements in a single chunk.
+	 */
+	template <class Type, uint64_t ChunkSize>
+	class chunked_vector_iterator final
+	{
+		using chunk_pointer = std::remove_const_t<Type> *;
+
+		const chunk_pointer *m_pChunks = nullptr;
+		Type *m_pCurrent = nullptr;
+		uint64_t m_Index = 0;
+
+		template <class, uint64_t>
+		friend class chunked_vector_iterator;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_const_t<Type>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Type *;
+		using reference = Type &;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr chunked_vector_iterator() = default;
+
+		/**
+		 * @brief Construct a new chunked vector iterator object.
+		 *
+		 * @param pChunks The chunk pointer array.
+		 * @param index The element index to point to.
+		 */
+		constexpr explicit chunked_vector_iterator(const chunk_pointer *pChunks, const uint64_t index) : m_pChunks(pChunks), m_Index(index) { resolve(); }
+
+		/**
+		 * @brief Conversion constructor from a mutable iterator to a const iterator.
+		 *
+		 * @param other The other iterator.
+		 */
+		template <class Other>
+		requires std::is_same_v<const Other, Type>
+		constexpr chunked_vector_iterator(const chunked_vector_iterator<Other, ChunkSize> &other) : m_pChunks(other.m_pChunks), m_pCurrent(other.m_pCurrent), m_Index(other.m_Index) {}
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The value reference.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return *m_pCurrent; }
+
+		/**
+		 * @brief Arrow operator.
+		 *
+		 * @return constexpr pointer The value pointer.
+		 */
+		constexpr INV_NODISCARD pointer operator->() const { return m_pCurrent; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param offset The offset to access.
+		 * @return constexpr reference The value reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const difference_type offset) const { return *(*this + offset); }
+
+		/**
+		 * @brief Pre-increment operator.
+		 * This only resolves the chunk when we step over a chunk boundary.
+		 *
+		 * @return constexpr chunked_vector_iterator& This iterator.
+		 */
+		constexpr chunked_vector_iterator &operator++()
+		{
+			if (++m_Index % ChunkSize == 0)
+				resolve();
+			else
+				++m_pCurrent;
+
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr chunked_vector_iterator The previous iterator.
+		 */
+		constexpr chunked_vector_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++(*this);
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Pre-decrement operator.
+		 *
+		 * @return constexpr chunked_vector_iterator& This iterator.
+		 */
+		constexpr chunked_vector_iterator &operator--()
+		{
+			--m_Index;
+			resolve();
+			return *this;
+		}
+
+		/**
+		 * @brief Post-decrement operator.
+		 *
+		 * @return constexpr chunked_vector_iterator The previous iterator.
+		 */
+		constexpr chunked_vector_iterator operator--(int)
+		{
+			auto thisCopy = *this;
+			--(*this);
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Increment-Assign operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr chunked_vector_iterator& This iterator.
+		 */
+		constexpr chunked_vector_iterator &operator+=(const difference_type offset)
+		{
+			m_Index += offset;
+			resolve();
+			return *this;
+		}
+
+		/**
+		 * @brief Decrement-Assign operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr chunked_vector_iterator& This iterator.
+		 */
+		constexpr chunked_vector_iterator &operator-=(const difference_type offset) { return *this += -offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr chunked_vector_iterator The new iterator.
+		 */
+		constexpr INV_NODISCARD chunked_vector_iterator operator+(const difference_type offset) const
+		{
+			auto thisCopy = *this;
+			return thisCopy += offset;
+		}
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @param iterator The iterator.
+		 * @return constexpr chunked_vector_iterator The new iterator.
+		 */
+		friend constexpr INV_NODISCARD chunked_vector_iterator operator+(const difference_type offset, const chunked_vector_iterator &iterator) { return iterator + offset; }
+
+		/**
+		 * @brief Subtraction operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr chunked_vector_iterator The new iterator.
+		 */
+		constexpr INV_NODISCARD chunked_vector_iterator operator-(const difference_type offset) const
+		{
+			auto thisCopy = *this;
+			return thisCopy -= offset;
+		}
+
+		/**
+		 * @brief Get the difference between this and another iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr difference_type The difference.
+		 */
+		constexpr INV_NODISCARD difference_type operator-(const chunked_vector_iterator &other) const { return static_cast<difference_type>(m_Index) - static_cast<difference_type>(other.m_Index); }
+
+		/**
+		 * @brief Is equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same element.
+		 * @return false if the iterators point to different elements.
+		 */
+		constexpr INV_NODISCARD bool operator==(const chunked_vector_iterator &other) const { return m_Index == other.m_Index; }
+
+		/**
+		 * @brief Three-way comparison operator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr auto The ordering.
+		 */
+		constexpr INV_NODISCARD auto operator<=>(const chunked_vector_iterator &other) const { return m_Index <=> other.m_Index; }
+
+	private:
+		/**
+		 * @brief Resolve the current pointer using the chunk array and the element index.
+		 * This leaves the pointer null if the chunk is not allocated (which is the case for the end iterator of a full chunk).
+		 */
+		constexpr void resolve()
+		{
+			const auto pChunk = m_pChunks ? m_pChunks[m_Index / ChunkSize] : nullptr;
+			m_pCurrent = pChunk ? pChunk + (m_Index % ChunkSize) : nullptr;
+		}
+	};
+
+	/**
+	 * @brief Chunked vector object.
+	 * This container stores its elements in fixed-size chunks which are never relocated once allocated. Because of this, growing the container never invalidates references to the
+	 * existing elements and there are no large reallocation copies. Each chunk is contiguous, so iterating over it is still cache friendly.
+	 *
+	 * @tparam Type The type of data to store.
+	 * @tparam ChunkSize The number of elements stored in a single chunk. This must be a power of two.
+	 * @tparam Allocator The allocator type. Default is std::allocator<Type>.
+	 */
+	template <class Type, uint64_t ChunkSize, class Allocator = std::allocator<Type>>
+	class chunked_vector final
+	{
+		static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "The chunk size must be a power of two!");
+
+		using allocator_traits = std::allocator_traits<Allocator>;
+		using chunk_table = std::vector<Type *, typename allocator_traits::template rebind_alloc<Type *>>;
+
+		// The chunk table has a trailing null pointer, so that the end iterator of a full chunk resolves safely.
+		chunk_table m_Chunks = chunk_table(1, nullptr);
+		uint64_t m_Size = 0;
+		Allocator m_Allocator = {};
+
+	public:
+		using value_type = Type;
+		using allocator_type = Allocator;
+		using size_type = uint64_t;
+		using reference = Type &;
+		using const_reference = const Type &;
+		using iterator = chunked_vector_iterator<Type, ChunkSize>;
+		using const_iterator = chunked_vector_iterator<const Type, ChunkSize>;
+		static constexpr uint64_t chunk_size = ChunkSize;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr chunked_vector() = default;
+
+		/**
+		 * @brief Construct a new chunked vector object.
+		 *
+		 * @param allocator The allocator used to allocate the chunks and the chunk table.
+		 */
+		constexpr explicit chunked_vector(const Allocator &allocator) : m_Chunks(1, nullptr, allocator), m_Allocator(allocator) {}
+
+		/**
+		 * @brief Copy constructor.
+		 *
+		 * @param other The other vector.
+		 */
+		chunked_vector(const chunked_vector &other) : chunked_vector(allocator_traits::select_on_container_copy_construction(other.m_Allocator))
+		{
+			reserve(other.m_Size);
+			for (const auto &element : other)
+				emplace_back(element);
+		}
+
+		/**
+		 * @brief Move constructor.
+		 *
+		 * @param other The other vector.
+		 */
+		chunked_vector(chunked_vector &&other) noexcept : m_Chunks(std::exchange(other.m_Chunks, chunk_table(1, nullptr, other.m_Chunks.get_allocator()))), m_Size(std::exchange(other.m_Size, 0)), m_Allocator(other.m_Allocator) {}
+
+		/**
+		 * @brief Destructor.
+		 */
+		~chunked_vector() { release(); }
+
+		/**
+		 * @brief Copy assignment operator.
+		 *
+		 * @param other The other vector.
+		 * @return chunked_vector& This object reference.
+		 */
+		chunked_vector &operator=(const chunked_vector &other)
+		{
+			if (this != &other)
+				*this = chunked_vector(other);
+
+			return *this;
+		}
+
+		/**
+		 * @brief Move assignment operator.
+		 * The chunks are taken over if the allocator propagates on move assignment or if both the allocators are equal. Otherwise the elements are moved one by one
+		 * into chunks allocated using this vector's allocator (like the standard containers do), and the other vector is cleared.
+		 *
+		 * @param other The other vector.
+		 * @return chunked_vector& This object reference.
+		 */
+		chunked_vector &operator=(chunked_vector &&other) noexcept(allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value)
+		{
+			if (this != &other)
+			{
+				release();
+
+				if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+					m_Allocator = std::move(other.m_Allocator);
+
+				if (allocator_traits::propagate_on_container_move_assignment::value || m_Allocator == other.m_Allocator)
+				{
+					m_Chunks = std::exchange(other.m_Chunks, chunk_table(1, nullptr, other.m_Chunks.get_allocator()));
+					m_Size = std::exchange(other.m_Size, 0);
+				}
+				else
+				{
+					reserve(other.m_Size);
+					for (auto &element : other)
+						emplace_back(std::move(element));
+
+					other.release();
+				}
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Emplace a new element at the back of the container.
+		 * This will allocate a new chunk if the last chunk is full.
+		 *
+		 * @tparam Types The constructor argument types.
+		 * @param arguments The constructor arguments.
+		 * @return constexpr reference The emplaced element reference.
+		 */
+		template <class... Types>
+		constexpr reference emplace_back(Types &&...arguments)
+		{
+			const auto chunkIndex = m_Size / ChunkSize;
+			if (chunkIndex == m_Chunks.size() - 1)
+			{
+				m_Chunks.back() = allocator_traits::allocate(m_Allocator, ChunkSize);
+				m_Chunks.emplace_back(nullptr);
+			}
+
+			auto pElement = m_Chunks[chunkIndex] + (m_Size % ChunkSize);
+			allocator_traits::construct(m_Allocator, pElement, std::forward<Types>(arguments)...);
+			++m_Size;
+
+			return *pElement;
+		}
+
+		/**
+		 * @brief Remove the last element of the container.
+		 * The chunk is kept for reuse.
+		 */
+		constexpr void pop_back()
+		{
+			--m_Size;
+			allocator_traits::destroy(m_Allocator, std::addressof((*this)[m_Size]));
+		}
+
+		/**
+		 * @brief Erase a single element from the container.
+		 * All the elements after it will be moved down by one.
+		 *
+		 * @param position The position to erase.
+		 * @return constexpr iterator The iterator to the element after the erased one.
+		 */
+		constexpr iterator erase(const_iterator position)
+		{
+			const auto index = static_cast<uint64_t>(position - cbegin());
+			for (auto i = index + 1; i < m_Size; ++i)
+				(*this)[i - 1] = std::move((*this)[i]);
+
+			pop_back();
+			return begin() + index;
+		}
+
+		/**
+		 * @brief Reserve enough chunks to store a given number of elements.
+		 *
+		 * @param count The element count.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			while (capacity() < count)
+			{
+				m_Chunks.back() = allocator_traits::allocate(m_Allocator, ChunkSize);
+				m_Chunks.emplace_back(nullptr);
+			}
+		}
+
+		/**
+		 * @brief Release all the chunks which does not contain any elements.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			const auto requiredChunks = (m_Size + ChunkSize - 1) / ChunkSize;
+			while (m_Chunks.size() - 1 > requiredChunks)
+			{
+				m_Chunks.pop_back();
+				allocator_traits::deallocate(m_Allocator, m_Chunks.back(), ChunkSize);
+				m_Chunks.back() = nullptr;
+			}
+
+			m_Chunks.shrink_to_fit();
+		}
+
+		/**
+		 * @brief Destroy all the elements and release all the chunks.
+		 */
+		constexpr void clear() { release(); }
+
+		/**
+		 * @brief Get the allocator used by the container.
+		 *
+		 * @return constexpr allocator_type The allocator.
+		 */
+		constexpr INV_NODISCARD allocator_type get_allocator() const { return m_Allocator; }
+
+		/**
+		 * @brief Get the number of elements stored.
+		 *
+		 * @return constexpr uint64_t The size.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Size; }
+
+		/**
+		 * @brief Check if the container is empty.
+		 *
+		 * @return true if the container is empty.
+		 * @return false if the container is not empty.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return m_Size == 0; }
+
+		/**
+		 * @brief Get the number of elements which can be stored without allocating a new chunk.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept { return (m_Chunks.size() - 1) * ChunkSize; }
+
+		/**
+		 * @brief Get the last element.
+		 *
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference back() { return (*this)[m_Size - 1]; }
+
+		/**
+		 * @brief Get the last element.
+		 *
+		 * @return constexpr const_reference The element reference.
+		 */
+		constexpr INV_NODISCARD const_reference back() const { return (*this)[m_Size - 1]; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param index The index to access.
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const uint64_t index) { return m_Chunks[index / ChunkSize][index % ChunkSize]; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param index The index to access.
+		 * @return constexpr const_reference The element reference.
+		 */
+		constexpr INV_NODISCARD const_reference operator[](const uint64_t index) const { return m_Chunks[index / ChunkSize][index % ChunkSize]; }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr iterator The iterator.
+		 */
+		constexpr INV_NODISCARD iterator begin() noexcept { return iterator(m_Chunks.data(), 0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr iterator The iterator.
+		 */
+		constexpr INV_NODISCARD iterator end() noexcept { return iterator(m_Chunks.data(), m_Size); }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator begin() const noexcept { return const_iterator(m_Chunks.data(), 0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator end() const noexcept { return const_iterator(m_Chunks.data(), m_Size); }
+
+		/**
+		 * @brief Get the const begin iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator cbegin() const noexcept { return begin(); }
+
+		/**
+		 * @brief Get the const end iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator cend() const noexcept { return end(); }
+
+	private:
+		/**
+		 * @brief Destroy all the elements and release all the chunks.
+		 */
+		constexpr void release()
+		{
+			while (m_Size > 0)
+				pop_back();
+
+			for (auto pChunk : m_Chunks)
+			{
+				if (pChunk)
+					allocator_traits::deallocate(m_Allocator, pChunk, ChunkSize);
+			}
+
+			m_Chunks.assign(1, nullptr);
+		}
+	};
+} // namespace inventory
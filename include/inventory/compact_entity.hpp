@@ -0,0 +1,209 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "component_traits.hpp"
+#include "bit_set.hpp"
+
+#include <bit>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Compact entity class.
+	 * This is an alternative to the entity class for registries with a large number of components. Rather than storing an index slot for every component of the
+	 * registry, it only stores the indexes of the components which are attached, in the order of the components. The position of a component index is found by
+	 * counting the attached components before it in the mask (the rank of the component), so the memory used by an entity scales with the number of attached
+	 * components instead of the number of components in the registry.
+	 *
+	 * @tparam ComponentIndex The component index type.
+	 * @tparam Allocator The allocator type used to store the component indexes.
+	 * @tparam Components The components that could be attached to this.
+	 */
+	template <index_type ComponentIndex, class Allocator, class... Components>
+	class compact_entity final
+	{
+		using bit_set_type = bit_set<get_component_count<Components...>()>;
+		using word_type = typename bit_set_type::word_type;
+
+		/**
+		 * @brief Create the mask of the components which have an index slot (the components which are not tags).
+		 *
+		 * @return consteval bit_set_type The mask.
+		 */
+		static consteval INV_NODISCARD bit_set_type create_storage_bits()
+		{
+			bit_set_type bits;
+			uint64_t position = 0;
+			((bits.toggle(position++, !tag_component<Components>)), ...);
+
+			return bits;
+		}
+
+		static constexpr bit_set_type storage_bits = create_storage_bits();
+
+	public:
+		using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<ComponentIndex>;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr compact_entity() = default;
+
+		/**
+		 * @brief Construct a new compact entity object.
+		 *
+		 * @param allocator The allocator used to store the component indexes.
+		 */
+		constexpr explicit compact_entity(const allocator_type &allocator) : m_Components(allocator) {}
+
+		/**
+		 * @brief Copy constructor.
+		 *
+		 * @param other The other entity.
+		 */
+		constexpr compact_entity(const compact_entity &other) = default;
+
+		/**
+		 * @brief Move constructor.
+		 *
+		 * @param other The other entity.
+		 */
+		constexpr compact_entity(compact_entity &&other) noexcept = default;
+
+		/**
+		 * @brief Allocator-extended copy constructor.
+		 *
+		 * @param other The other entity.
+		 * @param allocator The allocator used to store the component indexes.
+		 */
+		constexpr compact_entity(const compact_entity &other, const allocator_type &allocator) : m_Components(other.m_Components, allocator), m_Bits(other.m_Bits) {}
+
+		/**
+		 * @brief Allocator-extended move constructor.
+		 *
+		 * @param other The other entity.
+		 * @param allocator The allocator used to store the component indexes.
+		 */
+		constexpr compact_entity(compact_entity &&other, const allocator_type &allocator) : m_Components(std::move(other.m_Components), allocator), m_Bits(other.m_Bits) {}
+
+		/**
+		 * @brief Copy assignment operator.
+		 *
+		 * @param other The other entity.
+		 * @return compact_entity& This object reference.
+		 */
+		constexpr compact_entity &operator=(const compact_entity &other) = default;
+
+		/**
+		 * @brief Move assignment operator.
+		 *
+		 * @param other The other entity.
+		 * @return compact_entity& This object reference.
+		 */
+		constexpr compact_entity &operator=(compact_entity &&other) noexcept = default;
+
+		/**
+		 * @brief Register a component to this entity.
+		 * Tag components only toggle the bit, as they does not have an index slot. Registering an invalid index removes the slot of the component.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The component index.
+		 */
+		template <class Component>
+		constexpr void register_component(ComponentIndex index)
+		{
+			constexpr auto pos = ::inventory::get_component_index<Component, Components...>();
+			const auto isRegistered = index != invalid_index<ComponentIndex>;
+
+			if constexpr (!tag_component<Component>)
+			{
+				const auto slot = m_Components.begin() + get_rank(pos);
+
+				if (m_Bits.test(pos))
+				{
+					if (isRegistered)
+						*slot = index;
+
+					else
+						m_Components.erase(slot);
+				}
+				else if (isRegistered)
+					m_Components.insert(slot, index);
+			}
+
+			m_Bits.toggle(pos, isRegistered);
+		}
+
+		/**
+		 * @brief Get the component index of a component.
+		 * Make sure that this entity is registered to the component system before calling this method.
+		 *
+		 * @tparam Component The component type.
+		 * @return constexpr ComponentIndex The component index.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD ComponentIndex get_component_index() const
+		{
+			static_assert(!tag_component<Component>, "Tag components does not have a component index!");
+			assert((is_registered_to<Component>() && "This entity is not registered to this component! Make sure that the entity is registered to the component system before calling this."));
+			return m_Components[get_rank(::inventory::get_component_index<Component, Components...>())];
+		}
+
+		/**
+		 * @brief Check if the entity is registered to a system.
+		 *
+		 * @tparam Component The component of the system.
+		 * @return constexpr true if this entity is registered to the required system.
+		 * @return constexpr false if this entity is not registered to the required system.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD bool is_registered_to() const { return m_Bits[::inventory::get_component_index<Component, Components...>()]; }
+
+		/**
+		 * @brief Check if the entity is registered to a system or not.
+		 * This will use the component index to check if the entity is registered or not.
+		 *
+		 * @tparam Index The index to check.
+		 * @return constexpr true if this entity is registered to the required system.
+		 * @return constexpr false if this entity is not registered to the required system.
+		 */
+		template <ComponentIndex Index>
+		constexpr INV_NODISCARD bool is_registered_to() const { return m_Bits[Index]; }
+
+		/**
+		 * @brief Get the bits object containing the component availability info.
+		 *
+		 * @return constexpr bit_set The bit set containing the information.
+		 */
+		constexpr decltype(auto) get_bits() const { return m_Bits; }
+
+	private:
+		/**
+		 * @brief Get the number of attached components which have an index slot before a given component.
+		 *
+		 * @param pos The component position.
+		 * @return constexpr uint64_t The rank.
+		 */
+		constexpr INV_NODISCARD uint64_t get_rank(const uint64_t pos) const
+		{
+			const auto &words = m_Bits.container();
+			const auto &storageWords = storage_bits.container();
+			const auto lastWord = pos / bit_set_type::word_bits;
+
+			uint64_t rank = 0;
+			for (uint64_t i = 0; i < lastWord; i++)
+				rank += std::popcount(static_cast<word_type>(words[i] & storageWords[i]));
+
+			const auto lowerBits = (word_type(1) << (pos % bit_set_type::word_bits)) - 1;
+			return rank + std::popcount(static_cast<word_type>(words[lastWord] & storageWords[lastWord] & lowerBits));
+		}
+
+	private:
+		std::vector<ComponentIndex, allocator_type> m_Components;
+		bit_set_type m_Bits; // This is used to check if a component is in use.
+	};
+} // namespace inventory
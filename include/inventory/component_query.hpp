@@ -0,0 +1,94 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "component_query_iterator.hpp"
+#include "parallel.hpp"
+
+namespace inventory
+{
+	/**
+	 * @brief Component query object.
+	 * This object is used to iterate over the entities which match the required components, and yields the entity index along with the component references as a
+	 * tuple, which makes it structured binding friendly.
+	 *
+	 * @tparam EntityContainer The entity container type. This can be const qualified.
+	 * @tparam IndexIterator The entity index iterator type.
+	 * @tparam BitSet The bit set type.
+	 * @tparam Accessors The component accessor tuple type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
+	 */
+	template <class EntityContainer, class IndexIterator, class BitSet, class Accessors, class Filters = std::tuple<>>
+	class component_query final
+	{
+		using iterator = component_query_iterator<EntityContainer, IndexIterator, BitSet, Accessors, Filters>;
+
+		EntityContainer &m_Entities;
+		IndexIterator m_Begin;
+		IndexIterator m_End;
+		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+		const Accessors m_Accessors;
+		const Filters m_Filters;
+
+	public:
+		/**
+		 * @brief Construct a new component query object.
+		 *
+		 * @param entities The entity container.
+		 * @param first The first entity index iterator.
+		 * @param last The last entity index iterator.
+		 * @param bitset The bitset of the required components.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param accessors The component accessors.
+		 * @param filters The filters which are checked after the bit set test.
+		 */
+		explicit component_query(EntityContainer &entities, IndexIterator first, IndexIterator last, const BitSet bitset, const BitSet exclude, Accessors accessors, Filters filters = Filters())
+			: m_Entities(entities), m_Begin(first), m_End(last), m_BitSet(bitset), m_Exclude(exclude), m_Accessors(std::move(accessors)), m_Filters(std::move(filters)) {}
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) begin() const { return iterator(m_Entities, m_Begin, m_End, m_BitSet, m_Exclude, m_Accessors, m_Filters); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) end() const { return iterator(m_Entities, m_End, m_End, m_BitSet, m_Exclude, m_Accessors, m_Filters); }
+
+		/**
+		 * @brief Call a function for every matching entity using an execution policy.
+		 * The entities are split into chunks of a fixed size, and the chunks are processed using the policy. The function is called with the entity index followed by
+		 * the selected components, or only with the components if it does not accept the entity index. Entities and components must not be created or destroyed while
+		 * this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call.
+		 * @param chunkSize The number of entities processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), static_cast<uint64_t>(std::distance(m_Begin, m_End)), get_aligned_chunk_size<std::iter_value_t<IndexIterator>>(chunkSize), [this, &function](const uint64_t first, const uint64_t last)
+						   {
+							   const auto end = std::next(m_Begin, last);
+							   for (auto itr = std::next(m_Begin, first); itr != end; ++itr)
+							   {
+								   const auto index = *itr;
+								   const auto &ent = m_Entities[index];
+								   const auto bits = ent.get_bits();
+
+								   if (bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, ent))
+									   std::apply([&function, index, &ent](const auto &...accessors)
+												  { invoke_with_entity(function, index, accessors.fetch(ent)...); },
+												  m_Accessors);
+							   } });
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,243 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+#include "component_traits.hpp"
+#include "tick_filter.hpp"
+
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Required component accessor.
+	 * This is used by the component query iterator to fetch a component which is known to be present.
+	 *
+	 * @tparam System The system type. This can be const qualified.
+	 */
+	template <class System>
+	class required_component_accessor final
+	{
+		System *m_pSystem = nullptr;
+
+	public:
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr required_component_accessor() = default;
+
+		/**
+		 * @brief Construct a new required component accessor object.
+		 *
+		 * @param system The system to fetch the components from.
+		 */
+		constexpr explicit required_component_accessor(System &system) : m_pSystem(std::addressof(system)) {}
+
+		/**
+		 * @brief Fetch the component of an entity.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return constexpr decltype(auto) The component reference.
+		 */
+		template <class Entity>
+		constexpr INV_NODISCARD decltype(auto) fetch(const Entity &ent) const { return m_pSystem->get(ent); }
+	};
+
+	/**
+	 * @brief Optional component accessor.
+	 * This is used by the component query iterator to fetch a component which may not be present. Tags does not have any storage to point to, so optional tags are fetched as a boolean which states if the tag is present.
+	 *
+	 * @tparam System The system type. This can be const qualified.
+	 */
+	template <class System>
+	class optional_component_accessor final
+	{
+		using component_type = typename System::value_type;
+		using pointer = std::conditional_t<tag_component<component_type>, bool, std::conditional_t<std::is_const_v<System>, const component_type *, component_type *>>;
+
+		System *m_pSystem = nullptr;
+
+	public:
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr optional_component_accessor() = default;
+
+		/**
+		 * @brief Construct a new optional component accessor object.
+		 *
+		 * @param system The system to fetch the components from.
+		 */
+		constexpr explicit optional_component_accessor(System &system) : m_pSystem(std::addressof(system)) {}
+
+		/**
+		 * @brief Fetch the component of an entity.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return constexpr pointer The component pointer. This will be nullptr if the entity is not registered to the component. For tags this is whether the entity is
+		 * registered to the tag.
+		 */
+		template <class Entity>
+		constexpr INV_NODISCARD pointer fetch(const Entity &ent) const
+		{
+			if constexpr (tag_component<component_type>)
+				return ent.template is_registered_to<component_type>();
+
+			else
+			{
+				return ent.template is_registered_to<component_type>() ? std::addressof(m_pSystem->get(ent)) : nullptr;
+			}
+		}
+	};
+
+	/**
+	 * @brief Component query value type trait.
+	 * This resolves the tuple type which is yielded by the component query iterator.
+	 *
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Entity The entity type.
+	 * @tparam Accessors The component accessor tuple type.
+	 */
+	template <class EntityIndex, class Entity, class Accessors>
+	struct component_query_value;
+
+	/**
+	 * @brief Component query value type trait.
+	 * This resolves the tuple type which is yielded by the component query iterator.
+	 *
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Entity The entity type.
+	 * @tparam Accessors The component accessor types.
+	 */
+	template <class EntityIndex, class Entity, class... Accessors>
+	struct component_query_value<EntityIndex, Entity, std::tuple<Accessors...>>
+	{
+		using type = std::tuple<EntityIndex, decltype(std::declval<const Accessors &>().fetch(std::declval<const Entity &>()))...>;
+	};
+
+	/**
+	 * @brief Component query iterator class.
+	 * This iterator walks a list of entity indexes, skips the entities which does not match the masks and yields a tuple containing the entity index followed by the
+	 * selected components. The systems are resolved once when the iterator is created, and the entity is looked up once per step (the entity which passed the check
+	 * is kept and reused when the iterator is dereferenced).
+	 *
+	 * @tparam EntityContainer The entity container type. This can be const qualified.
+	 * @tparam IndexIterator The entity index iterator type.
+	 * @tparam BitSet The bit set type.
+	 * @tparam Accessors The component accessor tuple type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
+	 */
+	template <class EntityContainer, class IndexIterator, class BitSet, class Accessors, class Filters = std::tuple<>>
+	class component_query_iterator final
+	{
+		using entity_type = typename std::remove_const_t<EntityContainer>::value_type;
+
+		EntityContainer *m_pEntities = nullptr;
+		const entity_type *m_pEntity = nullptr;
+		IndexIterator m_Current;
+		IndexIterator m_Last;
+		BitSet m_BitSet;
+		BitSet m_Exclude;
+		Accessors m_Accessors;
+		Filters m_Filters;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using entity_index_type = std::iter_value_t<IndexIterator>;
+		using value_type = typename component_query_value<entity_index_type, entity_type, Accessors>::type;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr component_query_iterator() = default;
+
+		/**
+		 * @brief Construct a new component query iterator object.
+		 *
+		 * @param entities The entity container.
+		 * @param current The current entity index iterator.
+		 * @param last The last entity index iterator.
+		 * @param bitset The bitset of the required components.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param accessors The component accessors.
+		 * @param filters The filters which are checked after the bit set test.
+		 */
+		constexpr explicit component_query_iterator(EntityContainer &entities, const IndexIterator &current, const IndexIterator &last, const BitSet bitset, const BitSet exclude, const Accessors &accessors, const Filters &filters = Filters())
+			: m_pEntities(std::addressof(entities)), m_Current(current), m_Last(last), m_BitSet(bitset), m_Exclude(exclude), m_Accessors(accessors), m_Filters(filters)
+		{
+			// Skip to the first entity which uses the components.
+			while (m_Current != m_Last && !check())
+				++m_Current;
+		}
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity index and the component references.
+		 */
+		constexpr INV_NODISCARD reference operator*() const
+		{
+			return std::apply([index = *m_Current, &ent = *m_pEntity](const auto &...accessors)
+							  { return reference(index, accessors.fetch(ent)...); },
+							  m_Accessors);
+		}
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr component_query_iterator& The iterator reference.
+		 */
+		constexpr component_query_iterator &operator++()
+		{
+			while (++m_Current != m_Last && !check())
+				;
+
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr component_query_iterator The previous iterator.
+		 */
+		constexpr component_query_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same entity index.
+		 * @return false if the iterators point to different entity indexes.
+		 */
+		constexpr INV_NODISCARD bool operator==(const component_query_iterator &other) const { return m_Current == other.m_Current; }
+
+	private:
+		/**
+		 * @brief Check if the current entity uses the required components, none of the excluded components, and passes the filters.
+		 * The current entity is stored so that dereferencing does not need to look it up again.
+		 *
+		 * @return true if the current entity matches.
+		 * @return false if the current entity does not match.
+		 */
+		constexpr INV_NODISCARD bool check()
+		{
+			m_pEntity = std::addressof((*m_pEntities)[*m_Current]);
+			const auto bits = m_pEntity->get_bits();
+
+			return bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, *m_pEntity);
+		}
+	};
+} // namespace inventory
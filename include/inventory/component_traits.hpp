@@ -6,6 +6,7 @@
 #include "platform.hpp"
 
 #include <array>
+#include <type_traits>
 
 namespace inventory
 {
@@ -79,6 +80,76 @@ namespace inventory
 	template <class... Components>
 	consteval INV_NODISCARD uint64_t get_component_count() { return component_index_traits<Components...>::count; }
 
+	/**
+	 * @brief Tag component concept.
+	 * Empty component types are treated as tags. Tags are not stored in any system and does not take an index slot in the entity, they are only stored as a bit in the
+	 * entity's bit set.
+	 *
+	 * @tparam Component The component type.
+	 */
+	template <class Component>
+	concept tag_component = std::is_empty_v<Component>;
+
+	/**
+	 * @brief Change tracking traits struct.
+	 * Specialize this to enable the added and changed tick tracking of a component. Tracked components can be filtered using the added<...> and changed<...> query
+	 * filters.
+	 *
+	 * For example:
+	 * @code{cpp}
+	 * template <>
+	 * struct inventory::change_tracking_traits<transform_component>
+	 * {
+	 *     static constexpr bool enabled = true;
+	 * };
+	 * @endcode
+	 *
+	 * @tparam Component The component type.
+	 */
+	template <class Component>
+	struct change_tracking_traits
+	{
+		static constexpr bool enabled = false;
+	};
+
+	/**
+	 * @brief Tracked component concept.
+	 * This is satisfied by the components which has change tracking enabled. Tags does not have any data to change, so they are never tracked.
+	 *
+	 * @tparam Component The component type.
+	 */
+	template <class Component>
+	concept tracked_component = change_tracking_traits<Component>::enabled && !tag_component<Component>;
+
+	/**
+	 * @brief Get the number of components which require storage (components which are not tags) from a list of components.
+	 *
+	 * @tparam Components The components to count.
+	 * @return constexpr uint64_t The component count.
+	 */
+	template <class... Components>
+	consteval INV_NODISCARD uint64_t get_storage_component_count() { return (static_cast<uint64_t>(!tag_component<Components>) + ... + 0); }
+
+	/**
+	 * @brief Get the index slot of a given component in a list of components.
+	 * This is the index of the component when all the tag components are skipped.
+	 *
+	 * @tparam Component The component to get the slot of.
+	 * @tparam Components The components to index.
+	 * @return constexpr uint64_t The component's slot.
+	 */
+	template <class Component, class... Components>
+	consteval INV_NODISCARD uint64_t get_component_slot()
+	{
+		constexpr auto index = get_component_index<Component, Components...>();
+
+		uint64_t slot = 0;
+		uint64_t current = 0;
+		((slot += (current++ < index && !tag_component<Components>)), ...);
+
+		return slot;
+	}
+
 	/**
 	 * @brief Invalid index variable.
 	 * This constexpr variable contains the invalid index of a given component index type.
@@ -90,15 +161,16 @@ namespace inventory
 
 	/**
 	 * @brief Create a default component array object.
+	 * The array only contains slots for the components which are not tags.
 	 *
 	 * @tparam ComponentIndex The component index type.
 	 * @tparam Components The components.
-	 * @return consteval std::array<ComponentIndex, sizeof...(Components)> The created array.
+	 * @return consteval std::array<ComponentIndex, get_storage_component_count<Components...>()> The created array.
 	 */
 	template <index_type ComponentIndex, class... Components>
-	consteval INV_NODISCARD std::array<ComponentIndex, sizeof...(Components)> create_default_component_array()
+	consteval INV_NODISCARD std::array<ComponentIndex, get_storage_component_count<Components...>()> create_default_component_array()
 	{
-		std::array<ComponentIndex, sizeof...(Components)> componentArray;
+		std::array<ComponentIndex, get_storage_component_count<Components...>()> componentArray;
 		componentArray.fill(invalid_index<ComponentIndex>);
 
 		return componentArray;
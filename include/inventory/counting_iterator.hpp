@@ -0,0 +1,174 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <cstdint>
+#include <iterator>
+
+namespace inventory
+{
+	/**
+	 * @brief Counting iterator class.
+	 * This iterator yields consecutive integers without storing them anywhere, which lets the standard algorithms walk a range of positions (for example the chunks
+	 * of a parallel for each) without allocating a container for them.
+	 */
+	class counting_iterator final
+	{
+		uint64_t m_Value = 0;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using value_type = uint64_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const uint64_t *;
+		using reference = uint64_t;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr counting_iterator() = default;
+
+		/**
+		 * @brief Construct a new counting iterator object.
+		 *
+		 * @param value The value to point to.
+		 */
+		constexpr explicit counting_iterator(const uint64_t value) : m_Value(value) {}
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The current value.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return m_Value; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param offset The offset to access.
+		 * @return constexpr reference The value at the offset.
+		 */
+		constexpr INV_NODISCARD reference operator[](const difference_type offset) const { return m_Value + offset; }
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr counting_iterator& The iterator reference.
+		 */
+		constexpr counting_iterator &operator++()
+		{
+			++m_Value;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr counting_iterator The previous iterator.
+		 */
+		constexpr counting_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Pre-decrement operator.
+		 *
+		 * @return constexpr counting_iterator& The iterator reference.
+		 */
+		constexpr counting_iterator &operator--()
+		{
+			--m_Value;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-decrement operator.
+		 *
+		 * @return constexpr counting_iterator The previous iterator.
+		 */
+		constexpr counting_iterator operator--(int)
+		{
+			auto thisCopy = *this;
+			--*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Increment-Assign operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr counting_iterator& The iterator reference.
+		 */
+		constexpr counting_iterator &operator+=(const difference_type offset)
+		{
+			m_Value += offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Decrement-Assign operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr counting_iterator& The iterator reference.
+		 */
+		constexpr counting_iterator &operator-=(const difference_type offset) { return *this += -offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to add.
+		 * @return constexpr counting_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD counting_iterator operator+(counting_iterator iterator, const difference_type offset) { return iterator += offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @param iterator The iterator.
+		 * @return constexpr counting_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD counting_iterator operator+(const difference_type offset, counting_iterator iterator) { return iterator += offset; }
+
+		/**
+		 * @brief Subtraction operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to subtract.
+		 * @return constexpr counting_iterator The decremented iterator.
+		 */
+		friend constexpr INV_NODISCARD counting_iterator operator-(counting_iterator iterator, const difference_type offset) { return iterator -= offset; }
+
+		/**
+		 * @brief Get the difference between this and another iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr difference_type The difference.
+		 */
+		constexpr INV_NODISCARD difference_type operator-(const counting_iterator &other) const { return static_cast<difference_type>(m_Value) - static_cast<difference_type>(other.m_Value); }
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same value.
+		 * @return false if the iterators point to different values.
+		 */
+		constexpr INV_NODISCARD bool operator==(const counting_iterator &other) const { return m_Value == other.m_Value; }
+
+		/**
+		 * @brief Three-way comparison operator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr auto The comparison result.
+		 */
+		constexpr INV_NODISCARD auto operator<=>(const counting_iterator &other) const { return m_Value <=> other.m_Value; }
+	};
+} // namespace inventory
@@ -11,6 +11,24 @@ namespace inventory
 	// Set the default index type.
 	using default_index_type = uint32_t;
 
+	// Set the default number of indexes stored in a single sparse page. Every system allocates a whole page on its first registration, so this is kept small.
+	constexpr uint64_t default_page_size = 1024;
+
+	// Set the default number of entity positions which are collected by a single mask scan.
+	constexpr uint64_t default_scan_batch_size = 32;
+
+	// Set the default number of entity masks summarized by a single block summary mask.
+	constexpr uint64_t default_mask_block_size = 64;
+
+	// Set the default number of elements processed by a single parallel task.
+	constexpr uint64_t default_parallel_chunk_size = 1024;
+
+	// Set the cache line size used to align the parallel chunk boundaries.
+	constexpr uint64_t default_cache_line_size = 64;
+
+	// Set the alignment of the widest vector registers (AVX) used by the aligned storage.
+	constexpr uint64_t default_vector_alignment = 32;
+
 	/**
 	 * @brief Integral type concept.
 	 * This concept will only accept integral type.
@@ -0,0 +1,194 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "paged_index_array.hpp"
+
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Dense index set object.
+	 * This stores a set of indexes in an unordered, contiguous array, along with a paged back-index which maps every index to its position in the array. Inserting and
+	 * removing an index are constant time (removing swaps the last index into the freed position, the same way the sparse array does), and the indexes can be iterated
+	 * as a contiguous range.
+	 *
+	 * @tparam Index The index type.
+	 * @tparam Allocator The allocator type. Default is std::allocator<Index>.
+	 */
+	template <index_type Index, class Allocator = std::allocator<Index>>
+	class dense_index_set final
+	{
+		using dense_vector = std::vector<Index, Allocator>;
+		using position_pages = paged_index_array<Index, default_page_size, Allocator>;
+
+		dense_vector m_Indexes = {};	 // This is where we store the indexes.
+		position_pages m_Positions = {}; // This is where we store the position of each index.
+
+	public:
+		using value_type = Index;
+		using allocator_type = Allocator;
+		using iterator = typename dense_vector::const_iterator;
+		using const_iterator = typename dense_vector::const_iterator;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr dense_index_set() = default;
+
+		/**
+		 * @brief Construct a new dense index set object.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit dense_index_set(const Allocator &allocator) : m_Indexes(allocator), m_Positions(allocator) {}
+
+		/**
+		 * @brief Copy constructor using an allocator.
+		 * This is needed by allocator aware containers (like the polymorphic allocator) which store sets.
+		 *
+		 * @param other The other set.
+		 * @param allocator The allocator to use.
+		 */
+		dense_index_set(const dense_index_set &other, const Allocator &allocator) : m_Indexes(other.m_Indexes, allocator), m_Positions(allocator) { m_Positions = other.m_Positions; }
+
+		/**
+		 * @brief Move constructor using an allocator.
+		 * This is needed by allocator aware containers (like the polymorphic allocator) which store sets.
+		 *
+		 * @param other The other set.
+		 * @param allocator The allocator to use.
+		 */
+		dense_index_set(dense_index_set &&other, const Allocator &allocator) : m_Indexes(std::move(other.m_Indexes), allocator), m_Positions(allocator) { m_Positions = std::move(other.m_Positions); }
+
+		/**
+		 * @brief Copy constructor.
+		 *
+		 * @param other The other set.
+		 */
+		dense_index_set(const dense_index_set &other) = default;
+
+		/**
+		 * @brief Move constructor.
+		 *
+		 * @param other The other set.
+		 */
+		dense_index_set(dense_index_set &&other) noexcept = default;
+
+		/**
+		 * @brief Copy assignment operator.
+		 *
+		 * @param other The other set.
+		 * @return dense_index_set& This object reference.
+		 */
+		dense_index_set &operator=(const dense_index_set &other) = default;
+
+		/**
+		 * @brief Move assignment operator.
+		 *
+		 * @param other The other set.
+		 * @return dense_index_set& This object reference.
+		 */
+		dense_index_set &operator=(dense_index_set &&other) = default;
+
+		/**
+		 * @brief Insert an index to the set.
+		 *
+		 * @param index The index to insert.
+		 * @return true if the index was inserted.
+		 * @return false if the index was already in the set.
+		 */
+		constexpr bool insert(const Index index)
+		{
+			if (m_Positions.contains(index))
+				return false;
+
+			m_Positions.assign(index, static_cast<Index>(m_Indexes.size()));
+			m_Indexes.emplace_back(index);
+			return true;
+		}
+
+		/**
+		 * @brief Remove an index from the set.
+		 * The last index is moved to the position of the removed index.
+		 *
+		 * @param index The index to remove.
+		 */
+		constexpr void remove(const Index index)
+		{
+			if (!m_Positions.contains(index))
+				return;
+
+			const auto position = m_Positions[index];
+			const auto last = m_Indexes.back();
+
+			m_Indexes[position] = last;
+			m_Positions.assign(last, position);
+
+			m_Indexes.pop_back();
+			m_Positions.reset(index);
+		}
+
+		/**
+		 * @brief Check if the set contains an index.
+		 *
+		 * @param index The index to check.
+		 * @return true if the index is in the set.
+		 * @return false if the index is not in the set.
+		 */
+		constexpr INV_NODISCARD bool contains(const Index index) const { return m_Positions.contains(index); }
+
+		/**
+		 * @brief Reserve space for a number of indexes.
+		 *
+		 * @param count The number of indexes.
+		 */
+		constexpr void reserve(const uint64_t count) { m_Indexes.reserve(count); }
+
+		/**
+		 * @brief Remove all the indexes.
+		 */
+		constexpr void clear()
+		{
+			m_Indexes.clear();
+			m_Positions.clear();
+		}
+
+		/**
+		 * @brief Get the number of indexes in the set.
+		 *
+		 * @return constexpr uint64_t The index count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Indexes.size(); }
+
+		/**
+		 * @brief Check if the set is empty.
+		 *
+		 * @return true if the set is empty.
+		 * @return false if the set is not empty.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return m_Indexes.empty(); }
+
+		/**
+		 * @brief Get the allocator used by the set.
+		 *
+		 * @return constexpr allocator_type The allocator.
+		 */
+		constexpr INV_NODISCARD allocator_type get_allocator() const { return m_Indexes.get_allocator(); }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator begin() const { return m_Indexes.begin(); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator end() const { return m_Indexes.end(); }
+	};
+} // namespace inventory
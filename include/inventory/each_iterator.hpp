@@ -0,0 +1,191 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace inventory
+{
+	/**
+	 * @brief Each iterator class.
+	 * This iterator walks the packed entity array and the dense component array of a system in lockstep, and yields the owning entity index along with the component
+	 * reference.
+	 *
+	 * @tparam OwnerIterator The owning entity iterator type.
+	 * @tparam ComponentIterator The component iterator type.
+	 */
+	template <class OwnerIterator, class ComponentIterator>
+	class each_iterator final
+	{
+		OwnerIterator m_Owner;
+		ComponentIterator m_Component;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
+		using entity_index_type = std::iter_value_t<OwnerIterator>;
+		using component_reference = std::iter_reference_t<ComponentIterator>;
+		using value_type = std::pair<entity_index_type, component_reference>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr each_iterator() = default;
+
+		/**
+		 * @brief Construct a new each iterator object.
+		 *
+		 * @param owner The owning entity iterator.
+		 * @param component The component iterator.
+		 */
+		constexpr explicit each_iterator(OwnerIterator owner, ComponentIterator component) : m_Owner(owner), m_Component(component) {}
+
+		/**
+		 * @brief Get the owning entity index of the current component.
+		 *
+		 * @return constexpr entity_index_type The entity index.
+		 */
+		constexpr INV_NODISCARD entity_index_type entity() const { return *m_Owner; }
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity index and the component reference.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return reference(*m_Owner, *m_Component); }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param offset The offset to access.
+		 * @return constexpr reference The entity index and the component reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const difference_type offset) const { return *(*this + offset); }
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr each_iterator& The iterator reference.
+		 */
+		constexpr each_iterator &operator++()
+		{
+			++m_Owner;
+			++m_Component;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr each_iterator The previous iterator.
+		 */
+		constexpr each_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Pre-decrement operator.
+		 *
+		 * @return constexpr each_iterator& The iterator reference.
+		 */
+		constexpr each_iterator &operator--()
+		{
+			--m_Owner;
+			--m_Component;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-decrement operator.
+		 *
+		 * @return constexpr each_iterator The previous iterator.
+		 */
+		constexpr each_iterator operator--(int)
+		{
+			auto thisCopy = *this;
+			--*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Increment-Assign operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr each_iterator& The iterator reference.
+		 */
+		constexpr each_iterator &operator+=(const difference_type offset)
+		{
+			m_Owner += offset;
+			m_Component += offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Decrement-Assign operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr each_iterator& The iterator reference.
+		 */
+		constexpr each_iterator &operator-=(const difference_type offset) { return *this += -offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to add.
+		 * @return constexpr each_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD each_iterator operator+(each_iterator iterator, const difference_type offset) { return iterator += offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @param iterator The iterator.
+		 * @return constexpr each_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD each_iterator operator+(const difference_type offset, each_iterator iterator) { return iterator += offset; }
+
+		/**
+		 * @brief Subtraction operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to subtract.
+		 * @return constexpr each_iterator The decremented iterator.
+		 */
+		friend constexpr INV_NODISCARD each_iterator operator-(each_iterator iterator, const difference_type offset) { return iterator -= offset; }
+
+		/**
+		 * @brief Get the difference between this and another iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr difference_type The difference.
+		 */
+		constexpr INV_NODISCARD difference_type operator-(const each_iterator &other) const { return m_Owner - other.m_Owner; }
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same element.
+		 * @return false if the iterators point to different elements.
+		 */
+		constexpr INV_NODISCARD bool operator==(const each_iterator &other) const { return m_Owner == other.m_Owner; }
+
+		/**
+		 * @brief Three-way comparison operator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr auto The comparison result.
+		 */
+		constexpr INV_NODISCARD auto operator<=>(const each_iterator &other) const { return m_Owner <=> other.m_Owner; }
+	};
+} // namespace inventory
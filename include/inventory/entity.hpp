@@ -21,7 +21,7 @@ namespace inventory
 	{
 		using bit_set_type = bit_set<get_component_count<Components...>()>;
 
-		std::array<ComponentIndex, get_component_count<Components...>()> m_Components = create_default_component_array<ComponentIndex, Components...>();
+		std::array<ComponentIndex, get_storage_component_count<Components...>()> m_Components = create_default_component_array<ComponentIndex, Components...>();
 		bit_set_type m_Bits; // This is used to check if a component is in use.
 
 	public:
@@ -32,6 +32,7 @@ namespace inventory
 
 		/**
 		 * @brief Register a component to this entity.
+		 * Tag components only toggle the bit, as they does not have an index slot.
 		 *
 		 * @tparam Component The component type.
 		 * @param index The component index.
@@ -41,7 +42,9 @@ namespace inventory
 		{
 			constexpr auto pos = ::inventory::get_component_index<Component, Components...>();
 
-			m_Components[pos] = index;
+			if constexpr (!tag_component<Component>)
+				m_Components[::inventory::get_component_slot<Component, Components...>()] = index;
+
 			m_Bits.toggle(pos, index != invalid_index<ComponentIndex>);
 		}
 
@@ -55,8 +58,9 @@ namespace inventory
 		template <class Component>
 		constexpr INV_NODISCARD ComponentIndex get_component_index() const
 		{
+			static_assert(!tag_component<Component>, "Tag components does not have a component index!");
 			assert((is_registered_to<Component>() && "This entity is not registered to this component! Make sure that the entity is registered to the component system before calling this."));
-			return m_Components[::inventory::get_component_index<Component, Components...>()];
+			return m_Components[::inventory::get_component_slot<Component, Components...>()];
 		}
 
 		/**
@@ -2,15 +2,12 @@
 
 #include "defaults.hpp"
 #include "bit_set.hpp"
-#include "flat_set.hpp"
+#include "dense_index_set.hpp"
 #include "flat_map.hpp"
 
+#include <memory>
 #include <stdexcept>
-
-#ifdef INV_USE_UNSEQ
-#	include <execution>
-
-#endif
+#include <utility>
 
 namespace inventory
 {
@@ -31,16 +28,41 @@ namespace inventory
 
 	/**
 	 * @brief Entity component cache.
-	 * This object allows us to easily index all the entities with the required components attached to it.
+	 * This object allows us to easily index all the entities with the required components attached to it. Each registered sequence (the bits of the required
+	 * components) holds the unordered list of entities which uses those components, and the lists are incrementally updated (in constant time per sequence) as the entities change.
 	 *
-	 * @tparam EntityIndex
-	 * @tparam ComponentCount
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam ComponentCount The number of components.
+	 * @tparam Allocator The allocator type. Default is std::allocator<EntityIndex>.
 	 */
-	template </*index_type*/ class EntityIndex, uint64_t ComponentCount>
+	template </*index_type*/ class EntityIndex, uint64_t ComponentCount, class Allocator = std::allocator<EntityIndex>>
 	class entity_component_cache final
 	{
+		template <class Type>
+		using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+	public:
 		using bit_set_type = bit_set<ComponentCount>;
-		flat_map<bit_set_type, flat_set<EntityIndex>> m_Cache;
+		using entity_set_type = dense_index_set<EntityIndex, rebind_allocator<EntityIndex>>;
+
+	private:
+		flat_map<bit_set_type, entity_set_type, rebind_allocator<std::pair<bit_set_type, entity_set_type>>> m_Cache;
+
+		/**
+		 * @brief Create the bits of an index sequence.
+		 *
+		 * @tparam Type The type of the index.
+		 * @tparam Indexes The indexes.
+		 * @return constexpr bit_set_type The bit set.
+		 */
+		template <class Type, Type... Indexes>
+		static constexpr INV_NODISCARD bit_set_type create_bits()
+		{
+			bit_set_type bitSet;
+			(bitSet.toggle_true(Indexes), ...);
+
+			return bitSet;
+		}
 
 	public:
 		/**
@@ -48,6 +70,13 @@ namespace inventory
 		 */
 		constexpr entity_component_cache() = default;
 
+		/**
+		 * @brief Construct a new entity component cache object.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit entity_component_cache(const Allocator &allocator) : m_Cache(rebind_allocator<std::pair<bit_set_type, entity_set_type>>(allocator)) {}
+
 		/**
 		 * @brief Check if the sequence exists in the container.
 		 *
@@ -58,21 +87,7 @@ namespace inventory
 		 * @return false if the sequence does not exist.
 		 */
 		template <class Type, Type... Indexes>
-		constexpr INV_NODISCARD decltype(auto) sequence_exists([[maybe_unused]] const std::integer_sequence<Type, Indexes...> &sequence) const
-		{
-			bit_set_type bitSet;
-			(bitSet.toggle_true(Indexes), ...);
-
-#ifdef INV_USE_UNSEQ
-			return std::any_of(std::execution::unseq, m_Cache.begin(), m_Cache.end(), [bitSet](const auto &entry)
-							   { return entry.first && bitSet; });
-
-#else
-			return std::any_of(m_Cache.begin(), m_Cache.end(), [bitSet](const auto &entry)
-							   { return entry.first && bitSet; });
-
-#endif
-		}
+		constexpr INV_NODISCARD bool sequence_exists([[maybe_unused]] const std::integer_sequence<Type, Indexes...> &sequence) const { return contains(create_bits<Type, Indexes...>()); }
 
 		/**
 		 * @brief Get all the entities containing the index sequence.
@@ -80,47 +95,61 @@ namespace inventory
 		 * @tparam Type The type of the index.
 		 * @tparam Indexes The indexes.
 		 * @param sequence The sequence.
-		 * @return constexpr decltype(auto) The entities.
+		 * @return constexpr const entity_set_type& The entities.
 		 */
 		template <class Type, Type... Indexes>
-		constexpr INV_NODISCARD decltype(auto) get_entities([[maybe_unused]] const std::integer_sequence<Type, Indexes...> &sequence) const
+		constexpr INV_NODISCARD const entity_set_type &get_entities([[maybe_unused]] const std::integer_sequence<Type, Indexes...> &sequence) const
 		{
-			bit_set_type bitSet;
-			(bitSet.toggle_true(Indexes), ...);
-
-			for (const auto &[set, entities] : m_Cache)
-			{
-				// This container is what we want. So we can return the entities.
-				if (set && bitSet)
-					return entities;
-			}
+			const auto pEntities = find(create_bits<Type, Indexes...>());
+			if (pEntities == nullptr)
+				throw sequence_not_registered_error("The required sequence is not there in the system. Make sure to call sequence_exists() before calling this method.");
 
-			throw sequence_not_registered_error("The required sequence is not there in the system. Make sure to call sequence_exists() before calling this method.");
+			return *pEntities;
 		}
 
 		/**
-		 * @brief Get all the entities containing the index sequence.
+		 * @brief Check if a sequence is registered using its bits.
 		 *
-		 * @tparam Type The type of the index.
-		 * @tparam Indexes The indexes.
-		 * @param sequence The sequence.
-		 * @return constexpr decltype(auto) The entities.
+		 * @param bits The bits of the required components.
+		 * @return true if the sequence is registered.
+		 * @return false if the sequence is not registered.
 		 */
-		template <class Type, Type... Indexes>
-		constexpr INV_NODISCARD decltype(auto) get_entities([[maybe_unused]] const std::integer_sequence<Type, Indexes...> &sequence)
+		constexpr INV_NODISCARD bool contains(const bit_set_type &bits) const { return m_Cache.contains(bits); }
+
+		/**
+		 * @brief Find the entities of a sequence using its bits.
+		 *
+		 * @param bits The bits of the required components.
+		 * @return constexpr const entity_set_type* The entities. This will be nullptr if the sequence is not registered.
+		 */
+		constexpr INV_NODISCARD const entity_set_type *find(const bit_set_type &bits) const
 		{
-			bit_set_type bitSet;
-			(bitSet.toggle_true(Indexes), ...);
+			const auto itr = m_Cache.find(bits);
+			return itr != m_Cache.end() && itr->first == bits ? &itr->second : nullptr;
+		}
 
-			for (auto &[set, entities] : m_Cache)
-			{
-				// This container is what we want. So we can return the entities.
-				if (set && bitSet)
-					return entities;
-			}
+		/**
+		 * @brief Register a new sequence.
+		 * The returned entity set is empty if the sequence was not registered before, and should be filled with the entities which uses the required components.
+		 *
+		 * @param bits The bits of the required components.
+		 * @return constexpr entity_set_type& The entities of the sequence.
+		 */
+		constexpr INV_NODISCARD entity_set_type &register_sequence(const bit_set_type &bits) { return m_Cache[bits]; }
 
-			throw sequence_not_registered_error("The required sequence is not there in the system. Make sure to call sequence_exists() before calling this method.");
-		}
+		/**
+		 * @brief Unregister a sequence.
+		 *
+		 * @param bits The bits of the required components.
+		 */
+		constexpr void unregister_sequence(const bit_set_type &bits) { m_Cache.remove(bits); }
+
+		/**
+		 * @brief Get the number of registered sequences.
+		 *
+		 * @return constexpr uint64_t The sequence count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const { return m_Cache.size(); }
 
 		/**
 		 * @brief Add a new entity to the cache.
@@ -128,19 +157,13 @@ namespace inventory
 		 * @param bits The bits of the entity.
 		 * @param index The entity index.
 		 */
-		constexpr void add_entity(const bit_set_type bits, const EntityIndex index)
+		constexpr void add_entity(const bit_set_type &bits, const EntityIndex index)
 		{
-#ifdef INV_USE_UNSEQ
-			std::for_each(std::execution::unseq, m_Cache.begin(), m_Cache.end(), [bits, index](auto &entry)
-						  { if (entry.first || bits) entry.second.insert(index); });
-
-#else
-			std::for_each(m_Cache.begin(), m_Cache.end(), [bits, index](auto &entry)
-						  { if (entry.first || bits) entry.second.insert(index); });
-
-#endif
-
-			m_Cache[bits].insert(index);
+			for (auto &[sequence, entities] : m_Cache)
+			{
+				if (bits.contains(sequence))
+					[[maybe_unused]] const auto result = entities.insert(index);
+			}
 		}
 
 		/**
@@ -149,19 +172,36 @@ namespace inventory
 		 * @param bits The bits of the entity.
 		 * @param index The entity index.
 		 */
-		constexpr void remove_entity(const bit_set_type bits, const EntityIndex index)
+		constexpr void remove_entity(const bit_set_type &bits, const EntityIndex index)
 		{
-#ifdef INV_USE_UNSEQ
-			std::for_each(std::execution::unseq, m_Cache.begin(), m_Cache.end(), [bits, index](auto &entry)
-						  { if (entry.first || bits) entry.second.remove(index); });
+			for (auto &[sequence, entities] : m_Cache)
+			{
+				if (bits.contains(sequence))
+					entities.remove(index);
+			}
+		}
 
-#else
-			std::for_each(m_Cache.begin(), m_Cache.end(), [bits, index](auto &entry)
-						  { if (entry.first || bits) entry.second.remove(index); });
+		/**
+		 * @brief Update an entity after its components have changed.
+		 * The entity is only added to or removed from the sequences which it started or stopped matching.
+		 *
+		 * @param oldBits The bits of the entity before the change.
+		 * @param newBits The bits of the entity after the change.
+		 * @param index The entity index.
+		 */
+		constexpr void update_entity(const bit_set_type &oldBits, const bit_set_type &newBits, const EntityIndex index)
+		{
+			for (auto &[sequence, entities] : m_Cache)
+			{
+				const auto wasMatching = oldBits.contains(sequence);
+				const auto isMatching = newBits.contains(sequence);
 
-#endif
+				if (isMatching && !wasMatching)
+					[[maybe_unused]] const auto result = entities.insert(index);
 
-			// m_Cache[bits].remove(index);
+				else if (wasMatching && !isMatching)
+					entities.remove(index);
+			}
 		}
 	};
 } // namespace inventory
@@ -0,0 +1,118 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Entity handle error.
+	 * This error is thrown if a handle is requested for an entity index which does not fit in the index bits of a handle.
+	 */
+	class entity_handle_error final : public std::runtime_error
+	{
+	public:
+		/**
+		 * @brief Construct a new entity handle error object
+		 *
+		 * @param message The message to be thrown.
+		 */
+		explicit entity_handle_error(const char *message) : std::runtime_error(message) {}
+	};
+
+	/**
+	 * @brief Entity handle traits.
+	 * This specifies how the entity index and the generation are packed into a single handle value. The handle value is twice as wide as the index type, so the whole
+	 * index range can have a handle and the generation gets as many bits as the index. 64-bit indexes cannot be widened, so they are split into a 48-bit index and a
+	 * 16-bit generation instead. This can be specialized to use a different split for an index type.
+	 *
+	 * @tparam Index The index type.
+	 */
+	template <index_type Index>
+	struct entity_handle_traits final
+	{
+		using value_type = std::conditional_t<sizeof(Index) == 1, uint16_t, std::conditional_t<sizeof(Index) == 2, uint32_t, uint64_t>>;
+
+		static constexpr uint64_t generation_bits = sizeof(Index) < sizeof(uint64_t) ? sizeof(Index) * 8 : 16;
+		static constexpr uint64_t index_bits = sizeof(value_type) * 8 - generation_bits;
+
+		static constexpr Index index_mask = static_cast<Index>((uint64_t(1) << index_bits) - 1);
+		static constexpr Index generation_mask = static_cast<Index>((uint64_t(1) << generation_bits) - 1);
+	};
+
+	template <index_type EntityIndex, index_type ComponentIndex, class Allocator, class Layout, class... Components>
+	class basic_registry;
+
+	/**
+	 * @brief Entity handle class.
+	 * An entity handle packs the entity index along with the generation of the index into a single value. Every time an entity is destroyed, the generation of its
+	 * index is incremented, so a handle to a destroyed entity can be detected even after the index was reused by another entity. Handles can only be created by the
+	 * registry, so a handle always carries a generation which the registry handed out.
+	 *
+	 * Generations wrap around, so a handle which is kept while its index is reused 2^generation_bits times will alias the new entity.
+	 *
+	 * @tparam Index The index type.
+	 */
+	template <index_type Index>
+	class entity_handle final
+	{
+		using traits = entity_handle_traits<Index>;
+		using value_type = typename traits::value_type;
+
+		template <index_type EntityIndex, index_type ComponentIndex, class Allocator, class Layout, class... Components>
+		friend class basic_registry;
+
+		value_type m_Value = static_cast<value_type>(-1);
+
+		/**
+		 * @brief Construct a new entity handle object.
+		 *
+		 * @param index The entity index.
+		 * @param generation The generation of the index.
+		 */
+		constexpr explicit entity_handle(const Index index, const Index generation)
+			: m_Value(static_cast<value_type>((index & traits::index_mask) | (static_cast<value_type>(generation & traits::generation_mask) << traits::index_bits))) {}
+
+	public:
+		/**
+		 * @brief Default constructor.
+		 * A default constructed handle is never valid.
+		 */
+		constexpr entity_handle() = default;
+
+		/**
+		 * @brief Get the entity index.
+		 *
+		 * @return constexpr Index The index.
+		 */
+		constexpr INV_NODISCARD Index index() const noexcept { return static_cast<Index>(m_Value & traits::index_mask); }
+
+		/**
+		 * @brief Get the generation of the entity index.
+		 *
+		 * @return constexpr Index The generation.
+		 */
+		constexpr INV_NODISCARD Index generation() const noexcept { return static_cast<Index>(m_Value >> traits::index_bits); }
+
+		/**
+		 * @brief Get the packed value of the handle.
+		 *
+		 * @return constexpr value_type The value.
+		 */
+		constexpr INV_NODISCARD value_type value() const noexcept { return m_Value; }
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other handle.
+		 * @return true if both the handles refer to the same generation of the same index.
+		 * @return false if the handles are different.
+		 */
+		constexpr INV_NODISCARD bool operator==(const entity_handle &other) const noexcept { return m_Value == other.m_Value; }
+	};
+} // namespace inventory
@@ -0,0 +1,198 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Entity index iterator class.
+	 * This iterator walks a list of entity indexes (for example the owners of a system) and dereferences them to the entities stored in an entity container. This lets
+	 * queries iterate a subset of the entities using the same query iterators which are used to walk the whole entity container.
+	 *
+	 * @tparam EntityContainer The entity container type. This can be const qualified.
+	 * @tparam IndexIterator The entity index iterator type.
+	 */
+	template <class EntityContainer, class IndexIterator>
+	class entity_index_iterator final
+	{
+		EntityContainer *m_pContainer = nullptr;
+		IndexIterator m_Current;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename std::remove_const_t<EntityContainer>::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<std::is_const_v<EntityContainer>, const value_type &, value_type &>;
+		using pointer = std::conditional_t<std::is_const_v<EntityContainer>, const value_type *, value_type *>;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr entity_index_iterator() = default;
+
+		/**
+		 * @brief Construct a new entity index iterator object.
+		 *
+		 * @param container The entity container.
+		 * @param current The current entity index iterator.
+		 */
+		constexpr explicit entity_index_iterator(EntityContainer &container, IndexIterator current) : m_pContainer(std::addressof(container)), m_Current(current) {}
+
+		/**
+		 * @brief Get the index of the current entity.
+		 *
+		 * @return constexpr decltype(auto) The entity index.
+		 */
+		constexpr INV_NODISCARD decltype(auto) index() const { return *m_Current; }
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity reference.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return (*m_pContainer)[*m_Current]; }
+
+		/**
+		 * @brief Member access operator.
+		 *
+		 * @return constexpr pointer The entity pointer.
+		 */
+		constexpr INV_NODISCARD pointer operator->() const { return std::addressof(**this); }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param offset The offset to access.
+		 * @return constexpr reference The entity reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const difference_type offset) const { return (*m_pContainer)[m_Current[offset]]; }
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr entity_index_iterator& The iterator reference.
+		 */
+		constexpr entity_index_iterator &operator++()
+		{
+			++m_Current;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr entity_index_iterator The previous iterator.
+		 */
+		constexpr entity_index_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++m_Current;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Pre-decrement operator.
+		 *
+		 * @return constexpr entity_index_iterator& The iterator reference.
+		 */
+		constexpr entity_index_iterator &operator--()
+		{
+			--m_Current;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-decrement operator.
+		 *
+		 * @return constexpr entity_index_iterator The previous iterator.
+		 */
+		constexpr entity_index_iterator operator--(int)
+		{
+			auto thisCopy = *this;
+			--m_Current;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Increment-Assign operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr entity_index_iterator& The iterator reference.
+		 */
+		constexpr entity_index_iterator &operator+=(const difference_type offset)
+		{
+			m_Current += offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Decrement-Assign operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr entity_index_iterator& The iterator reference.
+		 */
+		constexpr entity_index_iterator &operator-=(const difference_type offset)
+		{
+			m_Current -= offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to add.
+		 * @return constexpr entity_index_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD entity_index_iterator operator+(entity_index_iterator iterator, const difference_type offset) { return iterator += offset; }
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @param iterator The iterator.
+		 * @return constexpr entity_index_iterator The incremented iterator.
+		 */
+		friend constexpr INV_NODISCARD entity_index_iterator operator+(const difference_type offset, entity_index_iterator iterator) { return iterator += offset; }
+
+		/**
+		 * @brief Subtraction operator.
+		 *
+		 * @param iterator The iterator.
+		 * @param offset The number to subtract.
+		 * @return constexpr entity_index_iterator The decremented iterator.
+		 */
+		friend constexpr INV_NODISCARD entity_index_iterator operator-(entity_index_iterator iterator, const difference_type offset) { return iterator -= offset; }
+
+		/**
+		 * @brief Get the difference between this and another iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr difference_type The difference.
+		 */
+		constexpr INV_NODISCARD difference_type operator-(const entity_index_iterator &other) const { return m_Current - other.m_Current; }
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same entity index.
+		 * @return false if the iterators point to different entity indexes.
+		 */
+		constexpr INV_NODISCARD bool operator==(const entity_index_iterator &other) const { return m_Current == other.m_Current; }
+
+		/**
+		 * @brief Three-way comparison operator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr auto The comparison result.
+		 */
+		constexpr INV_NODISCARD auto operator<=>(const entity_index_iterator &other) const { return m_Current <=> other.m_Current; }
+	};
+} // namespace inventory
@@ -0,0 +1,31 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "compact_entity.hpp"
+#include "entity.hpp"
+
+namespace inventory
+{
+	/**
+	 * @brief Dense entity layout policy.
+	 * Every entity stores an index slot for every component of the registry. Component lookups are a single array access, but the memory used by an entity grows with
+	 * the number of components in the registry. This is the default layout.
+	 */
+	struct dense_entity_layout final
+	{
+		template <index_type ComponentIndex, class Allocator, class... Components>
+		using entity = inventory::entity<ComponentIndex, Components...>;
+	};
+
+	/**
+	 * @brief Compact entity layout policy.
+	 * Every entity only stores the indexes of the components attached to it (see compact_entity), and finds them by counting the attached components before it in the
+	 * mask. This trades a few instructions per lookup for memory, and is meant for registries with a large number of components where entities only use a few of them.
+	 */
+	struct compact_entity_layout final
+	{
+		template <index_type ComponentIndex, class Allocator, class... Components>
+		using entity = compact_entity<ComponentIndex, Allocator, Components...>;
+	};
+} // namespace inventory
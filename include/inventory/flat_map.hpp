@@ -18,15 +18,17 @@ namespace inventory
 	 *
 	 * @tparam Key The key type.
 	 * @tparam Value The value type.
+	 * @tparam Allocator The allocator type. Default is std::allocator<std::pair<Key, Value>>.
 	 */
-	template <class Key, class Value>
+	template <class Key, class Value, class Allocator = std::allocator<std::pair<Key, Value>>>
 	class flat_map final
 	{
 	public:
 		using key_type = Key;
 		using value_type = Value;
+		using allocator_type = Allocator;
 		using entry_type = std::pair<key_type, value_type>;
-		using container_type = std::vector<entry_type>;
+		using container_type = std::vector<entry_type, Allocator>;
 		using iterator = typename container_type::iterator;
 		using const_iterator = typename container_type::const_iterator;
 
@@ -46,6 +48,13 @@ namespace inventory
 		 */
 		constexpr flat_map() = default;
 
+		/**
+		 * @brief Construct a new storage map object.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit flat_map(const Allocator &allocator) : m_Container(allocator) {}
+
 		/**
 		 * @brief Destroy the storage map object.
 		 */
@@ -116,6 +125,18 @@ namespace inventory
 			return itr != m_Container.end() && itr->first == key;
 		}
 
+		/**
+		 * @brief Remove an entry from the container using its key.
+		 *
+		 * @param key The key of the entry to remove.
+		 */
+		constexpr void remove(const key_type &key)
+		{
+			const auto itr = find(key);
+			if (itr != m_Container.end() && itr->first == key)
+				m_Container.erase(itr);
+		}
+
 		/**
 		 * @brief Get the begin iterator.
 		 *
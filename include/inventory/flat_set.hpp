@@ -16,13 +16,15 @@ namespace inventory
 	 * This class is just a set, but using a vector compared to a binary tree using nodes.
 	 *
 	 * @tparam Type The value type.
+	 * @tparam Allocator The allocator type. Default is std::allocator<Type>.
 	 */
-	template <class Type>
+	template <class Type, class Allocator = std::allocator<Type>>
 	class flat_set final
 	{
 	public:
 		using value_type = Type;
-		using container_type = std::vector<value_type>;
+		using allocator_type = Allocator;
+		using container_type = std::vector<value_type, Allocator>;
 		using iterator = typename container_type::iterator;
 		using const_iterator = typename container_type::const_iterator;
 
@@ -42,6 +44,31 @@ namespace inventory
 		 */
 		constexpr flat_set() = default;
 
+		/**
+		 * @brief Construct a new storage map object.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit flat_set(const Allocator &allocator) : m_Container(allocator) {}
+
+		/**
+		 * @brief Copy constructor using an allocator.
+		 * This is needed by allocator aware containers (like the polymorphic allocator) which store sets.
+		 *
+		 * @param other The other set.
+		 * @param allocator The allocator to use.
+		 */
+		constexpr flat_set(const flat_set &other, const Allocator &allocator) : m_Container(other.m_Container, allocator) {}
+
+		/**
+		 * @brief Move constructor using an allocator.
+		 * This is needed by allocator aware containers (like the polymorphic allocator) which store sets.
+		 *
+		 * @param other The other set.
+		 * @param allocator The allocator to use.
+		 */
+		constexpr flat_set(flat_set &&other, const Allocator &allocator) : m_Container(std::move(other.m_Container), allocator) {}
+
 		/**
 		 * @brief Destroy the storage map object.
 		 */
@@ -0,0 +1,152 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "group_iterator.hpp"
+#include "parallel.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+namespace inventory
+{
+	/**
+	 * @brief Group ownership error.
+	 * This error is thrown if a group is created using a component which is already owned by another group.
+	 */
+	class group_ownership_error final : public std::runtime_error
+	{
+	public:
+		/**
+		 * @brief Construct a new group ownership error object
+		 *
+		 * @param message The message to be thrown.
+		 */
+		explicit group_ownership_error(const char *message) : std::runtime_error(message) {}
+	};
+
+	/**
+	 * @brief Group object.
+	 * An owning group keeps the first few components of all of its systems aligned to the same entities, in the same order. This object is used to iterate over
+	 * those components, which is a linear walk over parallel arrays without any entity lookups or mask tests. Groups are created and maintained by the registry.
+	 *
+	 * Iterating a group does not mark the components as changed. Use registry::mark_changed() if the owned components track changes.
+	 *
+	 * @tparam Systems The owned system types.
+	 */
+	template <class... Systems>
+	class group final
+	{
+		using first_system = std::tuple_element_t<0, std::tuple<Systems...>>;
+		using owner_iterator = typename decltype(std::declval<const first_system &>().entities())::iterator;
+		using iterator = group_iterator<owner_iterator, typename Systems::iterator...>;
+
+		std::tuple<Systems *...> m_pSystems;
+		const uint64_t *m_pLength = nullptr;
+
+	public:
+		/**
+		 * @brief Construct a new group object.
+		 *
+		 * @param length The number of entities in the group. The group refers to this, so it stays up to date while the registry maintains the group.
+		 * @param systems The owned systems.
+		 */
+		constexpr explicit group(const uint64_t &length, Systems &...systems) : m_pSystems(std::addressof(systems)...), m_pLength(std::addressof(length)) {}
+
+		/**
+		 * @brief Get the number of entities in the group.
+		 *
+		 * @return constexpr uint64_t The entity count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return *m_pLength; }
+
+		/**
+		 * @brief Check if the group is empty.
+		 *
+		 * @return true if there are no entities in the group.
+		 * @return false if there is at least one entity in the group.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) begin() const { return create_iterator(0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) end() const { return create_iterator(size()); }
+
+		/**
+		 * @brief Call a function for every entity in the group using an execution policy.
+		 * The entities are split into cache aligned chunks of a fixed size, and the chunks are processed using the policy. The function is called with the entity index followed by
+		 * the owned components, or only with the components if it does not accept the entity index. Owned components must not be registered or unregistered while
+		 * this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call.
+		 * @param chunkSize The number of entities processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			const auto owners = std::get<0>(m_pSystems)->entities();
+			const auto firsts = std::apply([](auto *...pSystems)
+										   { return std::tuple(pSystems->begin()...); },
+										   m_pSystems);
+
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), size(), get_aligned_chunk_size<typename Systems::value_type...>(chunkSize), [owners, &firsts, &function](const uint64_t first, const uint64_t last)
+						   {
+							   for (auto i = first; i < last; i++)
+								   std::apply([&function, owner = owners[i], i](const auto &...components)
+											  { invoke_with_entity(function, owner, components[i]...); },
+											  firsts); });
+		}
+
+		/**
+		 * @brief Get a range which yields the entities and the owned components of the group in contiguous batches.
+		 * Every batch is a tuple containing the span of entity indexes followed by the spans of the owned components, and the spans of a batch are parallel. The batch
+		 * size is rounded up so that every batch starts on a cache line boundary relative to the first component of every owned system. This is only available when
+		 * all the owned components are stored contiguously.
+		 *
+		 * @param chunkSize The number of entities in a single batch. Default is default_parallel_chunk_size.
+		 * @return constexpr decltype(auto) The range of span tuples.
+		 */
+		constexpr INV_NODISCARD decltype(auto) chunks(const uint64_t chunkSize = default_parallel_chunk_size) const
+			requires(std::contiguous_iterator<typename Systems::iterator> && ...)
+		{
+			const auto pOwners = std::get<0>(m_pSystems)->entities().data();
+			const auto pComponents = std::apply([](auto *...pSystems)
+												{ return std::tuple(std::to_address(pSystems->begin())...); },
+												m_pSystems);
+
+			return create_chunk_view(size(), get_aligned_chunk_size<typename Systems::value_type...>(chunkSize), [pOwners, pComponents](const uint64_t first, const uint64_t last)
+									 { return std::apply([pOwners, first, last](auto *...pColumns)
+														 { return std::tuple(std::span(pOwners + first, last - first), std::span(pColumns + first, last - first)...); },
+														 pComponents); });
+		}
+
+	private:
+		/**
+		 * @brief Create an iterator which points to a given position of the group.
+		 *
+		 * @param position The position.
+		 * @return constexpr iterator The iterator.
+		 */
+		constexpr INV_NODISCARD iterator create_iterator(const uint64_t position) const
+		{
+			const auto offset = static_cast<std::ptrdiff_t>(position);
+			return std::apply([offset](auto *pFirst, auto *...pSystems)
+							  { return iterator(pFirst->entities().begin() + offset, pFirst->begin() + offset, (pSystems->begin() + offset)...); },
+							  m_pSystems);
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,95 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <iterator>
+#include <tuple>
+
+namespace inventory
+{
+	/**
+	 * @brief Group iterator class.
+	 * This iterator walks the packed entity array of the first owned system and the dense component arrays of all the owned systems of a group in lockstep, and
+	 * yields a tuple containing the entity index followed by the component references. Since the group keeps the owned components aligned, there is no entity lookup
+	 * or mask test per step.
+	 *
+	 * @tparam OwnerIterator The owning entity iterator type.
+	 * @tparam ComponentIterators The component iterator types.
+	 */
+	template <class OwnerIterator, class... ComponentIterators>
+	class group_iterator final
+	{
+		OwnerIterator m_Owner;
+		std::tuple<ComponentIterators...> m_Components;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using entity_index_type = std::iter_value_t<OwnerIterator>;
+		using value_type = std::tuple<entity_index_type, std::iter_reference_t<ComponentIterators>...>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr group_iterator() = default;
+
+		/**
+		 * @brief Construct a new group iterator object.
+		 *
+		 * @param owner The owning entity iterator.
+		 * @param components The component iterators.
+		 */
+		constexpr explicit group_iterator(OwnerIterator owner, ComponentIterators... components) : m_Owner(owner), m_Components(components...) {}
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity index and the component references.
+		 */
+		constexpr INV_NODISCARD reference operator*() const
+		{
+			return std::apply([this](const auto &...components)
+							  { return reference(*m_Owner, *components...); },
+							  m_Components);
+		}
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr group_iterator& The iterator reference.
+		 */
+		constexpr group_iterator &operator++()
+		{
+			++m_Owner;
+			std::apply([](auto &...components)
+					   { (++components, ...); },
+					   m_Components);
+
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr group_iterator The previous iterator.
+		 */
+		constexpr group_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same element.
+		 * @return false if the iterators point to different elements.
+		 */
+		constexpr INV_NODISCARD bool operator==(const group_iterator &other) const { return m_Owner == other.m_Owner; }
+	};
+} // namespace inventory
@@ -0,0 +1,303 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <span>
+#include <vector>
+
+#ifdef INV_USE_AVX2
+#	include <immintrin.h>
+
+#endif
+
+namespace inventory
+{
+	/**
+	 * @brief Mask column class.
+	 * This stores the component masks of the entities in a single packed array (in the same order as the dense entity array), so that queries which only need the
+	 * masks can scan them without striding over the rest of the entity data. The words of each mask are stored back to back.
+	 *
+	 * Every block of masks also has a summary mask, which is the bitwise OR of all the masks in the block. Scans skip the blocks whose summary does not contain the
+	 * required bits, so sparse queries only touch a small fraction of the masks.
+	 *
+	 * @tparam BitSet The bit set type used as the mask.
+	 * @tparam Allocator The allocator type. Default is std::allocator<typename BitSet::word_type>.
+	 * @tparam BlockSize The number of masks summarized by a single summary mask. Default is default_mask_block_size.
+	 */
+	template <class BitSet, class Allocator = std::allocator<typename BitSet::word_type>, uint64_t BlockSize = default_mask_block_size>
+	class mask_column final
+	{
+		using word_type = typename BitSet::word_type;
+		static constexpr uint64_t word_count = BitSet::word_count;
+
+		static_assert(BlockSize > 0, "The block size must be grater than 0!");
+
+		std::vector<word_type, Allocator> m_Words;
+		std::vector<word_type, Allocator> m_Summaries;
+
+	public:
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr mask_column() = default;
+
+		/**
+		 * @brief Construct a new mask column object.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		constexpr explicit mask_column(const Allocator &allocator) : m_Words(allocator), m_Summaries(allocator) {}
+
+		/**
+		 * @brief Insert a new mask to the back of the column.
+		 *
+		 * @param mask The mask to insert.
+		 */
+		constexpr void push_back(const BitSet &mask)
+		{
+			const auto position = size();
+			if (position % BlockSize == 0)
+				m_Summaries.insert(m_Summaries.end(), word_count, 0);
+
+			const auto &words = mask.container();
+			m_Words.insert(m_Words.end(), words.begin(), words.end());
+
+			auto pSummary = m_Summaries.data() + (position / BlockSize) * word_count;
+			for (uint64_t i = 0; i < word_count; i++)
+				pSummary[i] |= words[i];
+		}
+
+		/**
+		 * @brief Assign a mask to a given position.
+		 *
+		 * @param position The position of the mask.
+		 * @param mask The mask to assign.
+		 */
+		constexpr void assign(const uint64_t position, const BitSet &mask)
+		{
+			const auto &words = mask.container();
+			const auto pMask = m_Words.data() + position * word_count;
+
+			// If any bit was cleared, the summary needs to be recomputed. Otherwise we can just add the new bits to it.
+			bool isCleared = false;
+			for (uint64_t i = 0; i < word_count; i++)
+			{
+				isCleared |= (pMask[i] & ~words[i]) != 0;
+				pMask[i] = words[i];
+			}
+
+			if (isCleared)
+				update_summary(position / BlockSize);
+
+			else
+			{
+				auto pSummary = m_Summaries.data() + (position / BlockSize) * word_count;
+				for (uint64_t i = 0; i < word_count; i++)
+					pSummary[i] |= words[i];
+			}
+		}
+
+		/**
+		 * @brief Remove a mask from the column.
+		 * The last mask is moved to the removed position, which mirrors the swap-and-pop removal of the entity container.
+		 *
+		 * @param position The position of the mask to remove.
+		 */
+		constexpr void remove(const uint64_t position)
+		{
+			const auto last = m_Words.end() - word_count;
+			std::copy(last, m_Words.end(), m_Words.begin() + position * word_count);
+			m_Words.erase(last, m_Words.end());
+
+			// Drop the last summary if its block is now empty, and recompute the summaries of the blocks that changed.
+			const auto maskCount = size();
+			if (maskCount % BlockSize == 0)
+				m_Summaries.erase(m_Summaries.end() - word_count, m_Summaries.end());
+
+			if (position < maskCount)
+				update_summary(position / BlockSize);
+
+			if (maskCount % BlockSize != 0)
+				update_summary(maskCount / BlockSize);
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of masks without reallocating.
+		 *
+		 * @param count The number of masks.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			m_Words.reserve(count * word_count);
+			m_Summaries.reserve(((count + BlockSize - 1) / BlockSize) * word_count);
+		}
+
+		/**
+		 * @brief Release the unused memory of the column.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			m_Words.shrink_to_fit();
+			m_Summaries.shrink_to_fit();
+		}
+
+		/**
+		 * @brief Clear the column.
+		 */
+		constexpr void clear()
+		{
+			m_Words.clear();
+			m_Summaries.clear();
+		}
+
+		/**
+		 * @brief Get the number of masks stored in the column.
+		 *
+		 * @return constexpr uint64_t The mask count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept
+		{
+			if constexpr (word_count == 0)
+				return 0;
+
+			else
+				return m_Words.size() / word_count;
+		}
+
+		/**
+		 * @brief Scan the column for the masks which contain all the required bits and none of the excluded bits.
+		 * Scanning starts at the given position and stops when the output is full or when the last position is reached. Blocks whose summary does not contain the
+		 * required bits are skipped, and single word masks are compared four at a time when AVX2 is available.
+		 *
+		 * @param position The position to start scanning from. This will be set to the position where the scan stopped.
+		 * @param last The position to stop scanning at. This must not be grater than the size of the column.
+		 * @param required The required bits.
+		 * @param excluded The excluded bits.
+		 * @param output The output to store the matching positions.
+		 * @return uint64_t The number of matching positions stored in the output.
+		 */
+		uint64_t scan(uint64_t &position, const uint64_t last, const BitSet &required, const BitSet &excluded, std::span<uint64_t> output) const
+		{
+			const auto &requiredWords = required.container();
+			const auto &excludedWords = excluded.container();
+
+			uint64_t count = 0;
+			while (position < last && count < output.size())
+			{
+				const auto block = position / BlockSize;
+				const auto blockEnd = std::min((block + 1) * BlockSize, last);
+
+				// Skip the whole block if none of its masks can contain the required bits.
+				if (!contains(m_Summaries.data() + block * word_count, requiredWords))
+				{
+					position = blockEnd;
+					continue;
+				}
+
+#ifdef INV_USE_AVX2
+				if constexpr (word_count == 1)
+				{
+					const auto requiredVector = _mm256_set1_epi64x(static_cast<long long>(requiredWords[0]));
+					const auto excludedVector = _mm256_set1_epi64x(static_cast<long long>(excludedWords[0]));
+					const auto zero = _mm256_setzero_si256();
+
+					for (; position + 4 <= blockEnd && count + 4 <= output.size(); position += 4)
+					{
+						const auto masks = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_Words.data() + position));
+						const auto hasRequired = _mm256_cmpeq_epi64(_mm256_and_si256(masks, requiredVector), requiredVector);
+						const auto hasNoExcluded = _mm256_cmpeq_epi64(_mm256_and_si256(masks, excludedVector), zero);
+
+						auto matchBits = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_and_si256(hasRequired, hasNoExcluded))));
+						while (matchBits != 0)
+						{
+							output[count++] = position + std::countr_zero(matchBits);
+							matchBits &= matchBits - 1;
+						}
+					}
+				}
+
+#endif
+
+				for (; position < blockEnd && count < output.size(); position++)
+				{
+					if (matches(position, requiredWords, excludedWords))
+						output[count++] = position;
+				}
+			}
+
+			return count;
+		}
+
+	private:
+		/**
+		 * @brief Check if a mask contains all the required words.
+		 *
+		 * @tparam Words The word array type.
+		 * @param pMask The mask words.
+		 * @param required The required words.
+		 * @return true if the mask contains the required words.
+		 * @return false if the mask does not contain the required words.
+		 */
+		template <class Words>
+		static constexpr INV_NODISCARD bool contains(const word_type *pMask, const Words &required)
+		{
+			for (uint64_t i = 0; i < word_count; i++)
+			{
+				if ((pMask[i] & required[i]) != required[i])
+					return false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Recompute the summary mask of a block.
+		 *
+		 * @param block The block index.
+		 */
+		constexpr void update_summary(const uint64_t block)
+		{
+			const auto first = block * BlockSize;
+			const auto last = std::min(first + BlockSize, size());
+			const auto pSummary = m_Summaries.data() + block * word_count;
+
+			std::fill(pSummary, pSummary + word_count, 0);
+			for (auto position = first; position < last; position++)
+			{
+				const auto pMask = m_Words.data() + position * word_count;
+				for (uint64_t i = 0; i < word_count; i++)
+					pSummary[i] |= pMask[i];
+			}
+		}
+
+		/**
+		 * @brief Check if the mask at a given position contains all the required words and none of the excluded words.
+		 *
+		 * @tparam Words The word array type.
+		 * @param position The position of the mask.
+		 * @param required The required words.
+		 * @param excluded The excluded words.
+		 * @return true if the mask matches.
+		 * @return false if the mask does not match.
+		 */
+		template <class Words>
+		constexpr INV_NODISCARD bool matches(const uint64_t position, const Words &required, const Words &excluded) const
+		{
+			const auto pMask = m_Words.data() + position * word_count;
+
+			for (uint64_t i = 0; i < word_count; i++)
+			{
+				if ((pMask[i] & required[i]) != required[i] || (pMask[i] & excluded[i]) != 0)
+					return false;
+			}
+
+			return true;
+		}
+	};
+} // namespace inventory
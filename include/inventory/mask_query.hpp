@@ -0,0 +1,79 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "mask_query_iterator.hpp"
+#include "parallel.hpp"
+
+namespace inventory
+{
+	/**
+	 * @brief Mask query object.
+	 * This object is used to iterate over all the entities which match the required components by scanning the packed entity masks, rather than the entities
+	 * themselves.
+	 *
+	 * @tparam EntityContainer The entity container type. This can be const qualified.
+	 * @tparam MaskColumn The mask column type.
+	 * @tparam BitSet The bit set type.
+	 */
+	template <class EntityContainer, class MaskColumn, class BitSet>
+	class mask_query final
+	{
+		using iterator = mask_query_iterator<EntityContainer, MaskColumn, BitSet>;
+
+		EntityContainer &m_Entities;
+		const MaskColumn &m_Masks;
+		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+
+	public:
+		/**
+		 * @brief Construct a new mask query object.
+		 *
+		 * @param entities The entity container.
+		 * @param masks The mask column of the entities.
+		 * @param bitset The bitset of the required components.
+		 * @param exclude The bitset of the components which should not be present.
+		 */
+		explicit mask_query(EntityContainer &entities, const MaskColumn &masks, const BitSet bitset, const BitSet exclude)
+			: m_Entities(entities), m_Masks(masks), m_BitSet(bitset), m_Exclude(exclude) {}
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) begin() const { return iterator(m_Entities, m_Masks, m_BitSet, m_Exclude); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr decltype(auto) The iterator.
+		 */
+		constexpr INV_NODISCARD decltype(auto) end() const { return iterator(); }
+
+		/**
+		 * @brief Call a function for every matching entity using an execution policy.
+		 * The mask column is split into cache aligned chunks of a fixed size, and every chunk is scanned and processed using the policy. Entities and components must
+		 * not be created or destroyed while this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call. This is called with the entity reference.
+		 * @param chunkSize The number of masks processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), m_Masks.size(), get_aligned_chunk_size<BitSet>(chunkSize), [this, &function](uint64_t first, const uint64_t last)
+						   {
+							   std::array<uint64_t, default_scan_batch_size> batch = {};
+							   while (const auto count = m_Masks.scan(first, last, m_BitSet, m_Exclude, batch))
+							   {
+								   for (uint64_t i = 0; i < count; i++)
+									   function(m_Entities.begin()[batch[i]]);
+							   } });
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,145 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Mask query iterator class.
+	 * This iterator scans a mask column for the entities which match the required and excluded masks. Matching positions are collected in batches, and the entity
+	 * container is only accessed for the matching entities.
+	 *
+	 * @tparam EntityContainer The entity container type. This can be const qualified.
+	 * @tparam MaskColumn The mask column type.
+	 * @tparam BitSet The bit set type.
+	 * @tparam BatchSize The number of positions collected by a single scan. Default is default_scan_batch_size.
+	 */
+	template <class EntityContainer, class MaskColumn, class BitSet, uint64_t BatchSize = default_scan_batch_size>
+	class mask_query_iterator final
+	{
+		EntityContainer *m_pEntities = nullptr;
+		const MaskColumn *m_pMasks = nullptr;
+		BitSet m_BitSet;
+		BitSet m_Exclude;
+
+		std::array<uint64_t, BatchSize> m_Batch = {};
+		uint64_t m_BatchCount = 0;
+		uint64_t m_BatchIndex = 0;
+		uint64_t m_Position = 0;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename std::remove_const_t<EntityContainer>::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<std::is_const_v<EntityContainer>, const value_type &, value_type &>;
+		using pointer = std::conditional_t<std::is_const_v<EntityContainer>, const value_type *, value_type *>;
+
+		/**
+		 * @brief Default constructor.
+		 * The default constructed iterator is the end iterator.
+		 */
+		constexpr mask_query_iterator() = default;
+
+		/**
+		 * @brief Construct a new mask query iterator object.
+		 *
+		 * @param entities The entity container.
+		 * @param masks The mask column of the entities.
+		 * @param bitset The bitset of the required components.
+		 * @param exclude The bitset of the components which should not be present.
+		 */
+		constexpr explicit mask_query_iterator(EntityContainer &entities, const MaskColumn &masks, const BitSet bitset, const BitSet exclude)
+			: m_pEntities(std::addressof(entities)), m_pMasks(std::addressof(masks)), m_BitSet(bitset), m_Exclude(exclude)
+		{
+			fill_batch();
+		}
+
+		/**
+		 * @brief Get the dense position of the current entity.
+		 *
+		 * @return constexpr uint64_t The position.
+		 */
+		constexpr INV_NODISCARD uint64_t position() const { return m_Batch[m_BatchIndex]; }
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The entity reference.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return m_pEntities->begin()[position()]; }
+
+		/**
+		 * @brief Member access operator.
+		 *
+		 * @return constexpr pointer The entity pointer.
+		 */
+		constexpr INV_NODISCARD pointer operator->() const { return std::addressof(**this); }
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr mask_query_iterator& The iterator reference.
+		 */
+		constexpr mask_query_iterator &operator++()
+		{
+			if (++m_BatchIndex == m_BatchCount)
+				fill_batch();
+
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr mask_query_iterator The previous iterator.
+		 */
+		constexpr mask_query_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++*this;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Equal to operator.
+		 * Iterators are only compared using whether they are exhausted or not, as they are only compared against the end iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators are exhausted, or point to the same position.
+		 * @return false if the iterators point to different positions.
+		 */
+		constexpr INV_NODISCARD bool operator==(const mask_query_iterator &other) const
+		{
+			if (is_exhausted() || other.is_exhausted())
+				return is_exhausted() == other.is_exhausted();
+
+			return position() == other.position();
+		}
+
+	private:
+		/**
+		 * @brief Check if the iterator has passed the last matching entity.
+		 *
+		 * @return true if there are no more entities.
+		 * @return false if there are more entities.
+		 */
+		constexpr INV_NODISCARD bool is_exhausted() const { return m_BatchIndex == m_BatchCount; }
+
+		/**
+		 * @brief Fill the batch using the next set of matching entity positions.
+		 */
+		constexpr void fill_batch()
+		{
+			m_BatchIndex = 0;
+			m_BatchCount = m_pMasks->scan(m_Position, m_pMasks->size(), m_BitSet, m_Exclude, m_Batch);
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,323 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Paged index array object.
+	 * This object stores indexes in fixed-size pages which are allocated on demand. Ranges which does not contain any valid index does not have a page allocated to them (they are
+	 * null), and a page is released as soon as the last valid index in it is reset. This way the memory usage scales with the number of live entries rather than the maximum index.
+	 *
+	 * @tparam Index The index type to store.
+	 * @tparam PageSize The number of indexes stored in a single page. This must be a power of two. Default is default_page_size.
+	 * @tparam Allocator The allocator type. Default is std::allocator<Index>.
+	 */
+	template <index_type Index, uint64_t PageSize = default_page_size, class Allocator = std::allocator<Index>>
+	class paged_index_array final
+	{
+		static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "The page size must be a power of two!");
+
+		static constexpr Index invalid_index = -1;
+
+		/**
+		 * @brief Page structure.
+		 * This contains the indexes of a single page, and the number of valid indexes in it.
+		 */
+		struct page final
+		{
+			std::array<Index, PageSize> m_Indexes;
+			uint64_t m_Count = 0;
+
+			/**
+			 * @brief Default constructor.
+			 */
+			page() { m_Indexes.fill(invalid_index); }
+		};
+
+		using page_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<page>;
+		using page_allocator_traits = std::allocator_traits<page_allocator>;
+		using page_table = std::vector<page *, typename std::allocator_traits<Allocator>::template rebind_alloc<page *>>;
+
+		page_table m_Pages = {};		  // This is where we store the pages. Empty ranges are null.
+		uint64_t m_Size = 0;			  // The number of indexable entries (one past the highest index ever assigned).
+		page_allocator m_Allocator = {}; // This is used to allocate the pages.
+
+	public:
+		using value_type = Index;
+		using allocator_type = Allocator;
+		static constexpr uint64_t page_size = PageSize;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr paged_index_array() = default;
+
+		/**
+		 * @brief Construct a new paged index array object.
+		 *
+		 * @param allocator The allocator used to allocate the page table and the pages.
+		 */
+		constexpr explicit paged_index_array(const Allocator &allocator) : m_Pages(allocator), m_Allocator(allocator) {}
+
+		/**
+		 * @brief Copy constructor.
+		 * This will perform a deep copy of all the allocated pages.
+		 *
+		 * @param other The other array.
+		 */
+		paged_index_array(const paged_index_array &other)
+			: m_Pages(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())), m_Size(other.m_Size), m_Allocator(m_Pages.get_allocator())
+		{
+			m_Pages.reserve(other.m_Pages.size());
+			for (const auto pPage : other.m_Pages)
+				m_Pages.emplace_back(pPage ? create_page(*pPage) : nullptr);
+		}
+
+		/**
+		 * @brief Move constructor.
+		 *
+		 * @param other The other array.
+		 */
+		paged_index_array(paged_index_array &&other) noexcept : m_Pages(std::move(other.m_Pages)), m_Size(std::exchange(other.m_Size, 0)), m_Allocator(other.m_Allocator) { other.m_Pages.clear(); }
+
+		/**
+		 * @brief Destructor.
+		 */
+		~paged_index_array() { clear(); }
+
+		/**
+		 * @brief Copy assignment operator.
+		 *
+		 * @param other The other array.
+		 * @return paged_index_array& This object reference.
+		 */
+		paged_index_array &operator=(const paged_index_array &other)
+		{
+			if (this != &other)
+			{
+				clear();
+				m_Size = other.m_Size;
+				m_Pages.reserve(other.m_Pages.size());
+				for (const auto pPage : other.m_Pages)
+					m_Pages.emplace_back(pPage ? create_page(*pPage) : nullptr);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Move assignment operator.
+		 * The pages are taken over if the allocator propagates on move assignment or if both the allocators are equal. Otherwise the pages are copied using this
+		 * array's allocator (like the standard containers do), and the other array is cleared.
+		 *
+		 * @param other The other array.
+		 * @return paged_index_array& This object reference.
+		 */
+		paged_index_array &operator=(paged_index_array &&other) noexcept(page_allocator_traits::propagate_on_container_move_assignment::value || page_allocator_traits::is_always_equal::value)
+		{
+			if (this != &other)
+			{
+				clear();
+
+				if constexpr (page_allocator_traits::propagate_on_container_move_assignment::value)
+					m_Allocator = std::move(other.m_Allocator);
+
+				if (page_allocator_traits::propagate_on_container_move_assignment::value || m_Allocator == other.m_Allocator)
+				{
+					m_Pages = std::move(other.m_Pages);
+					other.m_Pages.clear();
+				}
+				else
+				{
+					m_Pages.reserve(other.m_Pages.size());
+					for (const auto pPage : other.m_Pages)
+						m_Pages.emplace_back(pPage ? create_page(*pPage) : nullptr);
+
+					other.clear();
+				}
+
+				m_Size = std::exchange(other.m_Size, 0);
+			}
+
+			return *this;
+		}
+
+		/**
+		 * @brief Get the allocator used by the array.
+		 *
+		 * @return constexpr allocator_type The allocator.
+		 */
+		constexpr INV_NODISCARD allocator_type get_allocator() const { return allocator_type(m_Allocator); }
+
+		/**
+		 * @brief Assign an index to a given position.
+		 * This will allocate the page if it does not exist.
+		 *
+		 * @param position The position to assign to.
+		 * @param index The index to assign.
+		 */
+		constexpr void assign(const uint64_t position, const Index index)
+		{
+			const auto pageIndex = position / PageSize;
+			if (pageIndex >= m_Pages.size())
+				m_Pages.resize(pageIndex + 1);
+
+			auto &pPage = m_Pages[pageIndex];
+			if (!pPage)
+				pPage = create_page();
+
+			auto &entry = pPage->m_Indexes[position % PageSize];
+			if (entry == invalid_index)
+				pPage->m_Count++;
+
+			entry = index;
+
+			if (position >= m_Size)
+				m_Size = position + 1;
+		}
+
+		/**
+		 * @brief Reset a given position to the invalid index.
+		 * This will release the page if it does not contain any more valid indexes.
+		 *
+		 * @param position The position to reset.
+		 */
+		constexpr void reset(const uint64_t position)
+		{
+			auto &pPage = m_Pages[position / PageSize];
+			auto &entry = pPage->m_Indexes[position % PageSize];
+
+			if (entry != invalid_index)
+			{
+				entry = invalid_index;
+
+				if (--pPage->m_Count == 0)
+					destroy_page(std::exchange(pPage, nullptr));
+			}
+		}
+
+		/**
+		 * @brief Check if a given position contains a valid index.
+		 *
+		 * @param position The position to check.
+		 * @return true if the position contains a valid index.
+		 * @return false if the position does not contain a valid index.
+		 */
+		constexpr INV_NODISCARD bool contains(const uint64_t position) const
+		{
+			if (position < m_Size)
+			{
+				const auto &pPage = m_Pages[position / PageSize];
+				return pPage && pPage->m_Indexes[position % PageSize] != invalid_index;
+			}
+
+			return false;
+		}
+
+		/**
+		 * @brief Clear the array.
+		 * This will release all the pages.
+		 */
+		constexpr void clear()
+		{
+			for (const auto pPage : m_Pages)
+			{
+				if (pPage)
+					destroy_page(pPage);
+			}
+
+			m_Pages.clear();
+			m_Size = 0;
+		}
+
+		/**
+		 * @brief Shrink the array to fit the optimal size.
+		 * This will drop all the trailing invalid entries and release the page table slots which are not used anymore.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			while (m_Size > 0 && !contains(m_Size - 1))
+				--m_Size;
+
+			m_Pages.resize((m_Size + PageSize - 1) / PageSize);
+			m_Pages.shrink_to_fit();
+		}
+
+		/**
+		 * @brief Get the number of indexable entries.
+		 * This is one past the highest position ever assigned since the last clear.
+		 *
+		 * @return constexpr uint64_t The size.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Size; }
+
+		/**
+		 * @brief Get the number of pages which are currently allocated.
+		 *
+		 * @return constexpr uint64_t The page count.
+		 */
+		constexpr INV_NODISCARD uint64_t allocated_page_count() const
+		{
+			uint64_t count = 0;
+			for (const auto pPage : m_Pages)
+				count += pPage != nullptr;
+
+			return count;
+		}
+
+		/**
+		 * @brief Subscript operator.
+		 * Make sure that the position contains a valid index before calling this.
+		 *
+		 * @param position The position to access.
+		 * @return constexpr Index& The index reference.
+		 */
+		constexpr INV_NODISCARD Index &operator[](const uint64_t position) { return m_Pages[position / PageSize]->m_Indexes[position % PageSize]; }
+
+		/**
+		 * @brief Subscript operator.
+		 * Make sure that the position contains a valid index before calling this.
+		 *
+		 * @param position The position to access.
+		 * @return constexpr const Index& The index reference.
+		 */
+		constexpr INV_NODISCARD const Index &operator[](const uint64_t position) const { return m_Pages[position / PageSize]->m_Indexes[position % PageSize]; }
+
+	private:
+		/**
+		 * @brief Allocate and construct a new page.
+		 *
+		 * @tparam Types The page constructor argument types.
+		 * @param arguments The page constructor arguments.
+		 * @return page* The created page.
+		 */
+		template <class... Types>
+		INV_NODISCARD page *create_page(Types &&...arguments)
+		{
+			auto pPage = page_allocator_traits::allocate(m_Allocator, 1);
+			page_allocator_traits::construct(m_Allocator, pPage, std::forward<Types>(arguments)...);
+
+			return pPage;
+		}
+
+		/**
+		 * @brief Destroy and deallocate a page.
+		 *
+		 * @param pPage The page to destroy.
+		 */
+		void destroy_page(page *pPage)
+		{
+			page_allocator_traits::destroy(m_Allocator, pPage);
+			page_allocator_traits::deallocate(m_Allocator, pPage, 1);
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,153 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "counting_iterator.hpp"
+#include "defaults.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#ifdef INV_USE_UNSEQ
+#	include <execution>
+
+#endif
+
+namespace inventory
+{
+#ifdef INV_USE_UNSEQ
+	/**
+	 * @brief Execution policy concept.
+	 * This is satisfied by the standard execution policies (std::execution::seq, par, par_unseq and unseq).
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<Type>>;
+
+#else
+	namespace execution
+	{
+		/**
+		 * @brief Sequenced policy structure.
+		 * This is used in place of std::execution::seq on platforms which do not ship the standard execution policies.
+		 */
+		struct sequenced_policy final
+		{
+		};
+
+		/**
+		 * @brief Sequenced execution policy.
+		 */
+		inline constexpr sequenced_policy seq{};
+	} // namespace execution
+
+	/**
+	 * @brief Execution policy concept.
+	 * The standard execution policies are not available on this platform, so only inventory::execution::seq is accepted and the chunks are processed in order.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	concept execution_policy = std::same_as<std::remove_cvref_t<Type>, execution::sequenced_policy>;
+
+#endif
+
+	/**
+	 * @brief Get the chunk size which makes every chunk boundary fall on a cache line boundary.
+	 * The chunk size is rounded up so that a chunk of elements always spans a whole number of cache lines, which stops two tasks from writing to the same cache line.
+	 * If multiple element types are given (for parallel arrays), the chunk size is aligned for all of them. Empty types (tags) are never stored, so they are ignored.
+	 *
+	 * @tparam Types The element types.
+	 * @param chunkSize The requested chunk size.
+	 * @return constexpr uint64_t The aligned chunk size.
+	 */
+	template <class... Types>
+	constexpr INV_NODISCARD uint64_t get_aligned_chunk_size(const uint64_t chunkSize)
+	{
+		constexpr uint64_t alignment = std::max({uint64_t(1), (std::is_empty_v<Types> ? uint64_t(1) : default_cache_line_size / std::gcd(default_cache_line_size, static_cast<uint64_t>(sizeof(Types))))...});
+		return std::max<uint64_t>((chunkSize + alignment - 1) / alignment, 1) * alignment;
+	}
+
+	/**
+	 * @brief Split a range into fixed size chunks and process them using an execution policy.
+	 * The chunk boundaries only depend on the element count and the chunk size, so the same range is always split the same way regardless of the number of threads.
+	 *
+	 * @tparam ExecutionPolicy The execution policy type.
+	 * @tparam Function The function type.
+	 * @param policy The execution policy.
+	 * @param count The number of elements in the range.
+	 * @param chunkSize The number of elements in a single chunk.
+	 * @param function The function which processes a single chunk. This is called with the first and last positions of the chunk.
+	 */
+	template <execution_policy ExecutionPolicy, class Function>
+	void for_each_chunk([[maybe_unused]] ExecutionPolicy &&policy, const uint64_t count, const uint64_t chunkSize, Function &&function)
+	{
+		if (count == 0)
+			return;
+
+		const auto processChunk = [count, chunkSize, &function](const uint64_t chunk)
+		{
+			const auto first = chunk * chunkSize;
+			function(first, std::min(first + chunkSize, count));
+		};
+
+		const auto chunkCount = (count + chunkSize - 1) / chunkSize;
+
+#ifdef INV_USE_UNSEQ
+		std::for_each(std::forward<ExecutionPolicy>(policy), counting_iterator(0), counting_iterator(chunkCount), processChunk);
+
+#else
+		std::for_each(counting_iterator(0), counting_iterator(chunkCount), processChunk);
+
+#endif
+	}
+
+	/**
+	 * @brief Create a range which splits a range into fixed size chunks.
+	 * The chunks are created lazily by calling a function with the first and last positions of each chunk, and the last chunk may be smaller than the others.
+	 *
+	 * @tparam Function The function type.
+	 * @param count The number of elements in the range.
+	 * @param chunkSize The number of elements in a single chunk.
+	 * @param function The function which creates a single chunk. This is called with the first and last positions of the chunk.
+	 * @return constexpr decltype(auto) The range of chunks.
+	 */
+	template <class Function>
+	constexpr INV_NODISCARD decltype(auto) create_chunk_view(const uint64_t count, const uint64_t chunkSize, Function function)
+	{
+		const auto createChunk = [count, chunkSize, function](const uint64_t chunk)
+		{
+			const auto first = chunk * chunkSize;
+			return function(first, std::min(first + chunkSize, count));
+		};
+
+		return std::views::iota(uint64_t(0), (count + chunkSize - 1) / chunkSize) | std::views::transform(createChunk);
+	}
+
+	/**
+	 * @brief Invoke a function with an entity index and the other arguments.
+	 * The entity index is dropped if the function does not accept it.
+	 *
+	 * @tparam Function The function type.
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Types The argument types.
+	 * @param function The function to invoke.
+	 * @param index The entity index.
+	 * @param arguments The arguments.
+	 */
+	template <class Function, class EntityIndex, class... Types>
+	constexpr void invoke_with_entity(Function &function, const EntityIndex index, Types &&...arguments)
+	{
+		if constexpr (std::is_invocable_v<Function &, Types...>)
+			function(std::forward<Types>(arguments)...);
+
+		else
+			function(index, std::forward<Types>(arguments)...);
+	}
+} // namespace inventory
@@ -7,6 +7,16 @@
 
 #endif
 
+#if defined(__AVX2__)
+#	define INV_USE_AVX2
+
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define INV_USE_SSE2
+
+#endif
+
 #ifdef __clang__
 #	define INV_NODISCARD
 
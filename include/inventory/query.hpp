@@ -3,6 +3,7 @@
 #pragma once
 
 #include "query_iterator.hpp"
+#include "parallel.hpp"
 
 namespace inventory
 {
@@ -12,13 +13,16 @@ namespace inventory
 	 *
 	 * @tparam EntityIterator The entity iterator type.
 	 * @tparam BitSet The bitset type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
 	 */
-	template <class EntityIterator, class BitSet>
+	template <class EntityIterator, class BitSet, class Filters = std::tuple<>>
 	class query final
 	{
 		EntityIterator m_Begin;
 		EntityIterator m_End;
 		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+		const Filters m_Filters;
 
 	public:
 		/**
@@ -27,22 +31,50 @@ namespace inventory
 		 * @param first The first iterator.
 		 * @param last The last iterator.
 		 * @param bitset The bitset to check.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param filters The filters which are checked after the bit set test.
 		 */
-		explicit query(EntityIterator &&first, EntityIterator &&last, const BitSet bitset) : m_Begin(std::move(first)), m_End(std::move(last)), m_BitSet(bitset) {}
+		explicit query(EntityIterator &&first, EntityIterator &&last, const BitSet bitset, const BitSet exclude = BitSet(), const Filters filters = Filters())
+			: m_Begin(std::move(first)), m_End(std::move(last)), m_BitSet(bitset), m_Exclude(exclude), m_Filters(filters) {}
 
 		/**
 		 * @brief Get the begin iterator.
 		 *
 		 * @return constexpr decltype(auto) The iterator.
 		 */
-		constexpr INV_NODISCARD decltype(auto) begin() { return query_iterator<EntityIterator, BitSet>(m_Begin, m_End, m_BitSet); }
+		constexpr INV_NODISCARD decltype(auto) begin() { return query_iterator<EntityIterator, BitSet, Filters>(m_Begin, m_End, m_BitSet, m_Exclude, m_Filters); }
 
 		/**
 		 * @brief Get the end iterator.
 		 *
 		 * @return constexpr decltype(auto) The iterator.
 		 */
-		constexpr INV_NODISCARD decltype(auto) end() { return query_iterator<EntityIterator, BitSet>(m_End, m_End, m_BitSet); }
+		constexpr INV_NODISCARD decltype(auto) end() { return query_iterator<EntityIterator, BitSet, Filters>(m_End, m_End, m_BitSet, m_Exclude, m_Filters); }
+
+		/**
+		 * @brief Call a function for every matching entity using an execution policy.
+		 * The entities are split into chunks of a fixed size, and the chunks are processed using the policy. Entities and components must not be created or destroyed
+		 * while this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call. This is called with the entity reference.
+		 * @param chunkSize The number of entities processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size)
+		{
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), static_cast<uint64_t>(std::distance(m_Begin, m_End)), get_aligned_chunk_size<std::iter_value_t<EntityIterator>>(chunkSize), [this, &function](const uint64_t first, const uint64_t last)
+						   {
+							   const auto end = std::next(m_Begin, last);
+							   for (auto itr = std::next(m_Begin, first); itr != end; ++itr)
+							   {
+								   const auto bits = (*itr).get_bits();
+								   if (bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, *itr))
+									   function(*itr);
+							   } });
+		}
 	};
 
 	/**
@@ -51,13 +83,16 @@ namespace inventory
 	 *
 	 * @tparam EntityIterator The entity iterator type.
 	 * @tparam BitSet The bitset type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
 	 */
-	template <class EntityIterator, class BitSet>
+	template <class EntityIterator, class BitSet, class Filters = std::tuple<>>
 	class const_query final
 	{
 		EntityIterator m_Begin;
 		EntityIterator m_End;
 		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+		const Filters m_Filters;
 
 	public:
 		/**
@@ -66,21 +101,49 @@ namespace inventory
 		 * @param first The first iterator.
 		 * @param last The last iterator.
 		 * @param bitset The bitset to check.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param filters The filters which are checked after the bit set test.
 		 */
-		explicit const_query(EntityIterator &&first, EntityIterator &&last, const BitSet bitset) : m_Begin(std::move(first)), m_End(std::move(last)), m_BitSet(bitset) {}
+		explicit const_query(EntityIterator &&first, EntityIterator &&last, const BitSet bitset, const BitSet exclude = BitSet(), const Filters filters = Filters())
+			: m_Begin(std::move(first)), m_End(std::move(last)), m_BitSet(bitset), m_Exclude(exclude), m_Filters(filters) {}
 
 		/**
 		 * @brief Get the begin iterator.
 		 *
 		 * @return constexpr decltype(auto) The iterator.
 		 */
-		constexpr INV_NODISCARD decltype(auto) begin() const { return const_query_iterator<EntityIterator, BitSet>(m_Begin, m_End, m_BitSet); }
+		constexpr INV_NODISCARD decltype(auto) begin() const { return const_query_iterator<EntityIterator, BitSet, Filters>(m_Begin, m_End, m_BitSet, m_Exclude, m_Filters); }
 
 		/**
 		 * @brief Get the end iterator.
 		 *
 		 * @return constexpr decltype(auto) The iterator.
 		 */
-		constexpr INV_NODISCARD decltype(auto) end() const { return const_query_iterator<EntityIterator, BitSet>(m_End, m_End, m_BitSet); }
+		constexpr INV_NODISCARD decltype(auto) end() const { return const_query_iterator<EntityIterator, BitSet, Filters>(m_End, m_End, m_BitSet, m_Exclude, m_Filters); }
+
+		/**
+		 * @brief Call a function for every matching entity using an execution policy.
+		 * The entities are split into chunks of a fixed size, and the chunks are processed using the policy. Entities and components must not be created or destroyed
+		 * while this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call. This is called with the entity reference.
+		 * @param chunkSize The number of entities processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), static_cast<uint64_t>(std::distance(m_Begin, m_End)), get_aligned_chunk_size<std::iter_value_t<EntityIterator>>(chunkSize), [this, &function](const uint64_t first, const uint64_t last)
+						   {
+							   const auto end = std::next(m_Begin, last);
+							   for (auto itr = std::next(m_Begin, first); itr != end; ++itr)
+							   {
+								   const auto bits = (*itr).get_bits();
+								   if (bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, *itr))
+									   function(*itr);
+							   } });
+		}
 	};
 } // namespace inventory
\ No newline at end of file
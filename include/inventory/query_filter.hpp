@@ -0,0 +1,152 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Exclude filter.
+	 * This can be passed to a query to skip the entities which are registered to any of the given components.
+	 *
+	 * @tparam Components The components to exclude.
+	 */
+	template <class... Components>
+	struct exclude final
+	{
+	};
+
+	/**
+	 * @brief Optional filter.
+	 * This can be passed to a query to mark components which may or may not be present. Optional components does not filter any entities, and can be accessed
+	 * through registry::try_get_component() which returns a null pointer if the entity is not registered to the component.
+	 *
+	 * @tparam Components The optional components.
+	 */
+	template <class... Components>
+	struct optional final
+	{
+	};
+
+	/**
+	 * @brief Added filter.
+	 * This can be passed to a query to only select the entities whose components were added after a given tick. The components must have change tracking enabled.
+	 *
+	 * @tparam Components The components to check.
+	 */
+	template <class... Components>
+	struct added final
+	{
+	};
+
+	/**
+	 * @brief Changed filter.
+	 * This can be passed to a query to only select the entities whose components were changed (or added) after a given tick. The components must have change tracking
+	 * enabled.
+	 *
+	 * @tparam Components The components to check.
+	 */
+	template <class... Components>
+	struct changed final
+	{
+	};
+
+	/**
+	 * @brief Is exclude filter type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_exclude_filter : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is exclude filter type trait.
+	 *
+	 * @tparam Components The excluded components.
+	 */
+	template <class... Components>
+	struct is_exclude_filter<exclude<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Is optional filter type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_optional_filter : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is optional filter type trait.
+	 *
+	 * @tparam Components The optional components.
+	 */
+	template <class... Components>
+	struct is_optional_filter<optional<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Is added filter type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_added_filter : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is added filter type trait.
+	 *
+	 * @tparam Components The components to check.
+	 */
+	template <class... Components>
+	struct is_added_filter<added<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Is changed filter type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_changed_filter : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is changed filter type trait.
+	 *
+	 * @tparam Components The components to check.
+	 */
+	template <class... Components>
+	struct is_changed_filter<changed<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Query filter concept.
+	 * This is satisfied by the exclude and optional filters.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	concept query_filter = is_exclude_filter<Type>::value || is_optional_filter<Type>::value;
+
+	/**
+	 * @brief Change filter concept.
+	 * This is satisfied by the added and changed filters. Unlike the other filters, these require the components, and are checked after the bit set test.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	concept change_filter = is_added_filter<Type>::value || is_changed_filter<Type>::value;
+} // namespace inventory
@@ -4,6 +4,7 @@
 
 #include "component_traits.hpp"
 #include "bit_set.hpp"
+#include "tick_filter.hpp"
 
 namespace inventory
 {
@@ -13,13 +14,16 @@ namespace inventory
 	 *
 	 * @tparam EntityIterator The entity iterator type.
 	 * @tparam BitSet The bit set type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
 	 */
-	template <class EntityIterator, class BitSet>
+	template <class EntityIterator, class BitSet, class Filters = std::tuple<>>
 	class query_iterator final
 	{
 		EntityIterator m_Current;
 		const EntityIterator m_Last;
 		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+		const Filters m_Filters;
 
 	public:
 		using value_type = typename EntityIterator::value_type;
@@ -35,9 +39,18 @@ namespace inventory
 		 * @brief Construct a new query iterator object.
 		 *
 		 * @param current The current iterator.
+		 * @param last The last iterator.
 		 * @param bitset The bitset to check.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param filters The filters which are checked after the bit set test.
 		 */
-		constexpr explicit query_iterator(EntityIterator &current, const EntityIterator &last, const BitSet bitset) : m_Current(current), m_Last(last), m_BitSet(bitset) {}
+		constexpr explicit query_iterator(EntityIterator &current, const EntityIterator &last, const BitSet bitset, const BitSet exclude = BitSet(), const Filters filters = Filters())
+			: m_Current(current), m_Last(last), m_BitSet(bitset), m_Exclude(exclude), m_Filters(filters)
+		{
+			// Skip to the first entity which uses the components.
+			while (m_Current != m_Last && !check())
+				++m_Current;
+		}
 
 		/**
 		 * @brief Dereference operator.
@@ -114,7 +127,7 @@ namespace inventory
 		constexpr INV_NODISCARD reference operator+=(int64_t number)
 		{
 			m_Current += number;
-			*this;
+			return *this;
 		}
 
 		friend constexpr INV_NODISCARD query_iterator operator+(const query_iterator &iterator, int64_t number);
@@ -129,7 +142,7 @@ namespace inventory
 		constexpr INV_NODISCARD reference operator-=(int64_t number)
 		{
 			m_Current -= number;
-			*this;
+			return *this;
 		}
 
 		friend constexpr INV_NODISCARD query_iterator operator-(const query_iterator &iterator, int64_t number);
@@ -206,12 +219,16 @@ namespace inventory
 
 	private:
 		/**
-		 * @brief Check if the entity's bitset contains all the values we need.
+		 * @brief Check if the entity's bitset contains all the values we need, none of the excluded values, and passes the filters.
 		 *
 		 * @return true if the current entity uses the components.
 		 * @return false if the current entity does not use the components.
 		 */
-		constexpr INV_NODISCARD bool check() const { return m_Current->get_bits() && m_BitSet; }
+		constexpr INV_NODISCARD bool check() const
+		{
+			const auto &bits = m_Current->get_bits();
+			return bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, *m_Current);
+		}
 	};
 
 	/**
@@ -280,13 +297,16 @@ namespace inventory
 	 *
 	 * @tparam EntityIterator The entity iterator type.
 	 * @tparam BitSet The bit set type.
+	 * @tparam Filters The tuple of filters which are checked after the bit set test. Default is an empty tuple.
 	 */
-	template <class EntityIterator, class BitSet>
+	template <class EntityIterator, class BitSet, class Filters = std::tuple<>>
 	class const_query_iterator final
 	{
 		EntityIterator m_Current;
 		const EntityIterator m_Last;
 		const BitSet m_BitSet;
+		const BitSet m_Exclude;
+		const Filters m_Filters;
 
 	public:
 		using value_type = typename EntityIterator::value_type;
@@ -302,9 +322,18 @@ namespace inventory
 		 * @brief Construct a new query iterator object.
 		 *
 		 * @param current The current iterator.
+		 * @param last The last iterator.
 		 * @param bitset The bitset to check.
+		 * @param exclude The bitset of the components which should not be present.
+		 * @param filters The filters which are checked after the bit set test.
 		 */
-		constexpr explicit const_query_iterator(const EntityIterator &current, const EntityIterator &last, const BitSet bitset) : m_Current(current), m_Last(last), m_BitSet(bitset) {}
+		constexpr explicit const_query_iterator(const EntityIterator &current, const EntityIterator &last, const BitSet bitset, const BitSet exclude = BitSet(), const Filters filters = Filters())
+			: m_Current(current), m_Last(last), m_BitSet(bitset), m_Exclude(exclude), m_Filters(filters)
+		{
+			// Skip to the first entity which uses the components.
+			while (m_Current != m_Last && !check())
+				++m_Current;
+		}
 
 		/**
 		 * @brief Dereference operator.
@@ -374,7 +403,7 @@ namespace inventory
 		constexpr INV_NODISCARD reference operator+=(int64_t number)
 		{
 			m_Current += number;
-			*this;
+			return *this;
 		}
 
 		friend constexpr INV_NODISCARD const_query_iterator operator+(const const_query_iterator &iterator, int64_t number);
@@ -389,7 +418,7 @@ namespace inventory
 		constexpr INV_NODISCARD reference operator-=(int64_t number)
 		{
 			m_Current -= number;
-			*this;
+			return *this;
 		}
 
 		friend constexpr INV_NODISCARD const_query_iterator operator-(const const_query_iterator &iterator, int64_t number);
@@ -466,12 +495,16 @@ namespace inventory
 
 	private:
 		/**
-		 * @brief Check if the entity uses the required components.
+		 * @brief Check if the entity uses the required components, none of the excluded components, and passes the filters.
 		 *
 		 * @return true if the current entity uses the components.
 		 * @return false if the current entity does not use the components.
 		 */
-		constexpr INV_NODISCARD bool check() const { return m_Current->get_bits() && m_BitSet; }
+		constexpr INV_NODISCARD bool check() const
+		{
+			const auto &bits = m_Current->get_bits();
+			return bits.contains(m_BitSet) && !bits.intersects(m_Exclude) && check_filters(m_Filters, *m_Current);
+		}
 	};
 
 	/**
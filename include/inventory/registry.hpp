@@ -3,40 +3,90 @@
 #pragma once
 
 #include "system.hpp"
+#include "entity_layout.hpp"
 #include "query.hpp"
+#include "entity_index_iterator.hpp"
+#include "query_filter.hpp"
+#include "component_query.hpp"
+#include "entity_component_cache.hpp"
+#include "mask_column.hpp"
+#include "mask_query.hpp"
+#include "tick_filter.hpp"
+#include "group.hpp"
+#include "entity_handle.hpp"
+
+#include <deque>
+#include <memory_resource>
+#include <span>
 
 namespace inventory
 {
 	/**
-	 * @brief Registry class.
+	 * @brief Basic registry class.
 	 * This class contains the mechanism for storing entities and components together, and to be able to easily access them.
 	 *
-	 * @tparam EntityIndex The entity index type. Default is default_index_type.
-	 * @tparam ComponentIndex The component index type. Default is default_index_type.
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam ComponentIndex The component index type.
+	 * @tparam Allocator The allocator type. This is rebound and passed down to every container in the registry, including all the systems.
+	 * @tparam Layout The entity layout policy (dense_entity_layout or compact_entity_layout).
 	 * @tparam Components The components to store in the registry.
 	 */
-	template <index_type EntityIndex = default_index_type, index_type ComponentIndex = default_index_type, class... Components>
-	class registry final
+	template <index_type EntityIndex, index_type ComponentIndex, class Allocator, class Layout, class... Components>
+	class basic_registry final
 	{
+		template <class Type>
+		using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+
+		using mask_type = bit_set<get_component_count<Components...>()>;
+		using mask_column_type = mask_column<mask_type, rebind_allocator<typename mask_type::word_type>>;
+
 	public:
 		using entity_index_type = EntityIndex;
 		using component_index_type = ComponentIndex;
-		using entity_type = entity<ComponentIndex, Components...>;
+		using allocator_type = Allocator;
+		using entity_type = typename Layout::template entity<ComponentIndex, rebind_allocator<ComponentIndex>, Components...>;
+		using handle_type = entity_handle<EntityIndex>;
 
 		template <class Component>
-		using system_type = system<Component, ComponentIndex>;
+		using system_type = system<Component, ComponentIndex, EntityIndex, typename storage_traits<Component>::policy, rebind_allocator<Component>>;
 
 		using system_container_type = std::tuple<system_type<Components>...>;
-		using entity_container_type = sparse_array<entity_type, EntityIndex>;
+		using entity_container_type = sparse_array<entity_type, EntityIndex, default_page_size, contiguous_storage, rebind_allocator<entity_type>>;
 
 		using callback_index = uint8_t;
-		using callback_type = std::function<void(registry &, const entity_index_type index)>;
-		using callback_container = std::array<sparse_array<callback_type, callback_index>, get_component_count<Components...>()>;
+		using callback_type = std::function<void(basic_registry &, const entity_index_type index)>;
+		using callback_array = sparse_array<callback_type, callback_index, default_page_size, contiguous_storage, rebind_allocator<callback_type>>;
+		using callback_container = std::array<callback_array, get_component_count<Components...>()>;
+		using cache_type = entity_component_cache<EntityIndex, get_component_count<Components...>(), rebind_allocator<EntityIndex>>;
+		using generation_container = std::vector<EntityIndex, rebind_allocator<EntityIndex>>;
 
 		/**
 		 * @brief Default constructor.
 		 */
-		constexpr registry() = default;
+		basic_registry() : basic_registry(Allocator()) {}
+
+		/**
+		 * @brief Construct a new registry object.
+		 * All the memory used by the registry (entities, systems, callback containers and the query cache) will be allocated using the given allocator.
+		 *
+		 * @param allocator The allocator to use.
+		 */
+		explicit basic_registry(const Allocator &allocator)
+			: m_Systems(system_type<Components>(rebind_allocator<Components>(allocator))...),
+			  m_Entities(rebind_allocator<entity_type>(allocator)),
+			  m_RegisterCallbacks(create_callback_container(allocator, std::make_index_sequence<get_component_count<Components...>()>())),
+			  m_UnregisterCallbacks(create_callback_container(allocator, std::make_index_sequence<get_component_count<Components...>()>())),
+			  m_Cache(rebind_allocator<EntityIndex>(allocator)),
+			  m_Masks(rebind_allocator<typename mask_type::word_type>(allocator)),
+			  m_Groups(rebind_allocator<owning_group>(allocator)),
+			  m_Generations(rebind_allocator<EntityIndex>(allocator)) {}
+
+		/**
+		 * @brief Get the allocator used by the registry.
+		 *
+		 * @return allocator_type The allocator.
+		 */
+		INV_NODISCARD allocator_type get_allocator() const { return allocator_type(m_Entities.get_allocator()); }
 
 		/**
 		 * @brief Get the system object from the registry.
@@ -61,18 +111,135 @@ namespace inventory
 		 *
 		 * @return constexpr entity_index_type The entity index.
 		 */
-		constexpr INV_NODISCARD entity_index_type create_entity() { return m_Entities.emplace().first; }
+		constexpr INV_NODISCARD entity_index_type create_entity()
+		{
+			const auto index = m_Entities.emplace().first;
+			m_Cache.add_entity(mask_type(), index);
+			m_Masks.push_back(mask_type());
+
+			// The generations are never released, so that the generations of the reused indexes keep counting up.
+			if (m_Generations.size() <= index)
+				m_Generations.resize(static_cast<uint64_t>(index) + 1, EntityIndex(0));
+
+			return index;
+		}
+
+		/**
+		 * @brief Create multiple entities at once.
+		 * This will reserve the required space once, rather than growing the entity storage for each entity.
+		 *
+		 * @param count The number of entities to create.
+		 * @return std::vector<entity_index_type> The created entity indexes.
+		 */
+		INV_NODISCARD std::vector<entity_index_type> create_entities(const uint64_t count)
+		{
+			std::vector<entity_index_type> indexes;
+			indexes.reserve(count);
+			m_Entities.reserve(m_Entities.size() + count);
+			m_Masks.reserve(m_Entities.size() + count);
+			m_Generations.reserve(m_Entities.size() + count);
+
+			for (uint64_t i = 0; i < count; i++)
+				indexes.emplace_back(create_entity());
+
+			return indexes;
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of entities without reallocating.
+		 *
+		 * @param count The number of entities.
+		 */
+		constexpr void reserve_entities(const uint64_t count)
+		{
+			m_Entities.reserve(count);
+			m_Masks.reserve(count);
+			m_Generations.reserve(count);
+		}
+
+		/**
+		 * @brief Reserve enough space in a system to store a given number of components without reallocating.
+		 *
+		 * @tparam Component The component type.
+		 * @param count The number of components.
+		 */
+		template <class Component>
+		constexpr void reserve(const uint64_t count) { get_system<Component>().reserve(count); }
+
+		/**
+		 * @brief Get the number of entities that can be stored without reallocating.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t entity_capacity() const noexcept { return m_Entities.capacity(); }
+
+		/**
+		 * @brief Get the number of components a system can store without reallocating.
+		 *
+		 * @tparam Component The component type.
+		 * @return constexpr uint64_t The capacity.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept { return get_system<Component>().capacity(); }
+
+		/**
+		 * @brief Release the unused memory of the entity storage and all the systems.
+		 * This is useful after destroying a large number of entities.
+		 */
+		constexpr void trim()
+		{
+			m_Entities.shrink_to_fit();
+			m_Masks.shrink_to_fit();
+			(get_system<Components>().shrink_to_fit(), ...);
+		}
 
 		/**
 		 * @brief Destroy an entity from the registry.
-		 * This will unregister the entity from all the systems it is attached to.
+		 * This will unregister the entity from all the systems it is attached to. The entity is removed from the query cache in a single pass before the components are
+		 * released, instead of updating the cache once per component.
 		 *
 		 * @param index The entity index.
 		 */
 		constexpr void destroy_entity(const entity_index_type index)
 		{
-			(unregister_from_system<Components>(index), ...);
+			m_Cache.remove_entity(get_entity(index).get_bits(), index);
+			m_Masks.assign(m_Entities.position_of(index), mask_type());
+
+			((invoke_unregister_callbacks<Components>(index), unregister_from_system<Components>(get_entity(index))), ...);
+
+			m_Masks.remove(m_Entities.position_of(index));
 			m_Entities.remove(index);
+
+			m_Generations[index] = static_cast<EntityIndex>((m_Generations[index] + 1) & entity_handle_traits<EntityIndex>::generation_mask);
+		}
+
+		/**
+		 * @brief Get the handle of an entity.
+		 * The handle stores the generation of the entity index, which can be used to check if the entity was destroyed (even if the index was reused afterwards).
+		 * This throws an entity_handle_error if the index does not fit in the index bits of a handle (see entity_handle_traits).
+		 *
+		 * @param index The index of the entity. The entity must be alive.
+		 * @return constexpr handle_type The entity handle.
+		 */
+		constexpr INV_NODISCARD handle_type get_handle(const entity_index_type index) const
+		{
+			if (index >= entity_handle_traits<EntityIndex>::index_mask)
+				throw entity_handle_error("The entity index does not fit in an entity handle! Use a larger entity index type or fewer generation bits.");
+
+			return handle_type(index, m_Generations[index]);
+		}
+
+		/**
+		 * @brief Check if an entity handle still refers to a live entity.
+		 * The generations wrap around after 2^generation_bits reuses of the same index, after which a stale handle is reported as valid again (see entity_handle_traits).
+		 *
+		 * @param handle The entity handle.
+		 * @return true if the entity of the handle is alive.
+		 * @return false if the entity was destroyed or the handle was never issued.
+		 */
+		constexpr INV_NODISCARD bool valid(const handle_type handle) const noexcept
+		{
+			return handle.index() < entity_handle_traits<EntityIndex>::index_mask && handle.index() < m_Generations.size() && m_Generations[handle.index()] == handle.generation();
 		}
 
 		/**
@@ -98,19 +265,89 @@ namespace inventory
 		 * @tparam Types The argument types.
 		 * @param index The entity index.
 		 * @param arguments The arguments to be forwarded to create the component.
-		 * @return constexpr Component& The created component reference.
+		 * @return constexpr decltype(auto) The created component reference.
 		 */
 		template <class Component, class... Types>
-		constexpr INV_NODISCARD Component &register_to_system(const entity_index_type index, Types &&...arguments)
+		constexpr INV_NODISCARD decltype(auto) register_to_system(const entity_index_type index, Types &&...arguments)
 		{
 			auto &callbacks = m_RegisterCallbacks[get_component_index<Component, Components...>()];
 			std::for_each(callbacks.begin(), callbacks.end(), [this, index](auto &callback)
 						  { callback(*this, index); });
 
-			return get_system<Component>().register_entity(get_entity(index), std::forward<Types>(arguments)...);
+			auto &entity = get_entity(index);
+			const auto oldBits = entity.get_bits();
+
+			auto &system = get_system<Component>();
+			decltype(auto) component = system.register_entity(entity, index, std::forward<Types>(arguments)...);
+			on_entity_bits_changed(entity, index, oldBits);
+
+			if constexpr (tracked_component<Component>)
+				system.mark_added(entity, m_CurrentTick);
+
+			if constexpr (tag_component<Component>)
+				return component;
+
+			else
+			{
+				// Joining a group moves the component, so it has to be fetched again.
+				add_to_groups<Component>(entity, oldBits);
+				return system.get(entity);
+			}
+		}
+
+		/**
+		 * @brief Register multiple entities to a system.
+		 * The system storage is reserved once, every component is constructed using the same arguments in a single pass, and the callbacks are fired in batch (each callback
+		 * is called for all the entities before moving on to the next one).
+		 *
+		 * @tparam Component The component to register to.
+		 * @tparam Types The argument types.
+		 * @param indexes The entity indexes.
+		 * @param arguments The arguments used to create each of the components.
+		 */
+		template <class Component, class... Types>
+		void register_to_system(std::span<const entity_index_type> indexes, const Types &...arguments)
+		{
+			for (auto &callback : m_RegisterCallbacks[get_component_index<Component, Components...>()])
+			{
+				for (const auto index : indexes)
+					callback(*this, index);
+			}
+
+			auto &system = get_system<Component>();
+			system.reserve(system.size() + indexes.size());
+
+			for (const auto index : indexes)
+			{
+				auto &entity = get_entity(index);
+				const auto oldBits = entity.get_bits();
+
+				[[maybe_unused]] decltype(auto) component = system.register_entity(entity, index, arguments...);
+				on_entity_bits_changed(entity, index, oldBits);
+
+				if constexpr (tracked_component<Component>)
+					system.mark_added(entity, m_CurrentTick);
+
+				add_to_groups<Component>(entity, oldBits);
+			}
 		}
 
 	private:
+		/**
+		 * @brief Update the query cache and the mask column after the components of an entity have changed.
+		 *
+		 * @param entity The entity.
+		 * @param index The entity index.
+		 * @param oldBits The bits of the entity before the change.
+		 */
+		constexpr void on_entity_bits_changed(const entity_type &entity, const entity_index_type index, const mask_type &oldBits)
+		{
+			const auto newBits = entity.get_bits();
+
+			m_Cache.update_entity(oldBits, newBits, index);
+			m_Masks.assign(m_Entities.position_of(index), newBits);
+		}
+
 		/**
 		 * @brief Unregister an entity from a system.
 		 *
@@ -121,24 +358,104 @@ namespace inventory
 		constexpr void unregister_from_system(entity_type &entity)
 		{
 			if (entity.template is_registered_to<Component>())
+			{
+				remove_from_groups<Component>(entity);
 				get_system<Component>().unregister_entity(entity);
+			}
 		}
 
-	public:
 		/**
-		 * @brief Unregister an entity from a system.
+		 * @brief Invoke the unregister callbacks of a component.
 		 *
 		 * @tparam Component The component type.
 		 * @param index The entity index.
 		 */
 		template <class Component>
-		constexpr void unregister_from_system(const entity_index_type index)
+		constexpr void invoke_unregister_callbacks(const entity_index_type index)
 		{
 			auto &callbacks = m_UnregisterCallbacks[get_component_index<Component, Components...>()];
 			std::for_each(callbacks.begin(), callbacks.end(), [this, index](auto &callback)
 						  { callback(*this, index); });
+		}
+
+		/**
+		 * @brief Move an entity into the group which owns a component, if the entity now has all the owned components.
+		 *
+		 * @tparam Component The component which was registered.
+		 * @param entity The entity.
+		 * @param oldBits The bits of the entity before the component was registered.
+		 */
+		template <class Component>
+		constexpr void add_to_groups(const entity_type &entity, const mask_type &oldBits)
+		{
+			const auto bits = entity.get_bits();
+			for (auto &owningGroup : m_Groups)
+			{
+				if (owningGroup.m_Owned.test(get_component_index<Component, Components...>()))
+				{
+					if (!oldBits.contains(owningGroup.m_Owned) && bits.contains(owningGroup.m_Owned))
+						owningGroup.m_pMove(*this, entity, owningGroup.m_Length++);
+
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @brief Move an entity out of the group which owns a component, before the component is unregistered.
+		 *
+		 * @tparam Component The component which is being unregistered.
+		 * @param entity The entity.
+		 */
+		template <class Component>
+		constexpr void remove_from_groups(const entity_type &entity)
+		{
+			for (auto &owningGroup : m_Groups)
+			{
+				if (owningGroup.m_Owned.test(get_component_index<Component, Components...>()))
+				{
+					if (entity.get_bits().contains(owningGroup.m_Owned))
+						owningGroup.m_pMove(*this, entity, --owningGroup.m_Length);
+
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @brief Move an entity's components to a given position of all the owned systems of a group.
+		 * The components which were at that position are moved to where the entity's components were.
+		 *
+		 * @tparam Owned The owned components.
+		 * @param self The registry.
+		 * @param entity The entity.
+		 * @param position The position to move the components to.
+		 */
+		template <class... Owned>
+		static void move_to_group_position(basic_registry &self, const entity_type &entity, const uint64_t position)
+		{
+			([&self, &entity, position](auto &system)
+			 { system.swap_positions(system.position_of(entity), position); }(self.template get_system<Owned>()),
+			 ...);
+		}
+
+	public:
+		/**
+		 * @brief Unregister an entity from a system.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 */
+		template <class Component>
+		constexpr void unregister_from_system(const entity_index_type index)
+		{
+			invoke_unregister_callbacks<Component>(index);
+
+			auto &entity = get_entity(index);
+			const auto oldBits = entity.get_bits();
 
-			unregister_from_system<Component>(get_entity(index));
+			unregister_from_system<Component>(entity);
+			on_entity_bits_changed(entity, index, oldBits);
 		}
 
 		/**
@@ -146,40 +463,195 @@ namespace inventory
 		 *
 		 * @tparam Component The component type.
 		 * @param index The entity index.
-		 * @return constexpr Component& The component reference.
+		 * @return constexpr decltype(auto) The component reference.
 		 */
 		template <class Component>
-		constexpr INV_NODISCARD Component &get_component(const entity_index_type index) { return get_system<Component>().get(get_entity(index)); }
+		constexpr INV_NODISCARD decltype(auto) get_component(const entity_index_type index) { return get_component<Component>(get_entity(index)); }
 
 		/**
 		 * @brief Get a component from the system.
 		 *
 		 * @tparam Component The component type.
 		 * @param index The entity index.
-		 * @return constexpr const Component& The component reference.
+		 * @return constexpr decltype(auto) The component reference.
 		 */
 		template <class Component>
-		constexpr INV_NODISCARD const Component &get_component(const entity_index_type index) const { return get_system<Component>().get(get_entity(index)); }
+		constexpr INV_NODISCARD decltype(auto) get_component(const entity_index_type index) const { return get_system<Component>().get(get_entity(index)); }
 
 		/**
 		 * @brief Get a component from the system.
+		 * This does not mark the component as changed. Use patch() or mark_changed() when the component is modified.
 		 *
 		 * @tparam Component The component type.
 		 * @param ent The entity.
-		 * @return constexpr Component& The component reference.
+		 * @return constexpr decltype(auto) The component reference.
 		 */
 		template <class Component>
-		constexpr INV_NODISCARD Component &get_component(const entity_type &ent) { return get_system<Component>().get(ent); }
+		constexpr INV_NODISCARD decltype(auto) get_component(const entity_type &ent) { return get_system<Component>().get(ent); }
 
 		/**
 		 * @brief Get a component from the system.
 		 *
 		 * @tparam Component The component type.
 		 * @param ent The entity.
-		 * @return constexpr const Component& The component reference.
+		 * @return constexpr decltype(auto) The component reference.
+		 */
+		template <class Component>
+		constexpr INV_NODISCARD decltype(auto) get_component(const entity_type &ent) const { return get_system<Component>().get(ent); }
+
+		/**
+		 * @brief Try and get a component from the system.
+		 * This is useful when accessing optional components of a query.
+		 *
+		 * @tparam Component The component type.
+		 * @param ent The entity.
+		 * @return constexpr Component* The component pointer. This will be nullptr if the entity is not registered to the component.
+		 */
+		template <class Component>
+			requires std::is_reference_v<typename system_type<Component>::reference>
+		constexpr INV_NODISCARD Component *try_get_component(const entity_type &ent) { return ent.template is_registered_to<Component>() ? std::addressof(get_component<Component>(ent)) : nullptr; }
+
+		/**
+		 * @brief Try and get a component from the system.
+		 * This is useful when accessing optional components of a query.
+		 *
+		 * @tparam Component The component type.
+		 * @param ent The entity.
+		 * @return constexpr const Component* The component pointer. This will be nullptr if the entity is not registered to the component.
+		 */
+		template <class Component>
+			requires std::is_reference_v<typename system_type<Component>::reference>
+		constexpr INV_NODISCARD const Component *try_get_component(const entity_type &ent) const { return ent.template is_registered_to<Component>() ? std::addressof(get_system<Component>().get(ent)) : nullptr; }
+
+		/**
+		 * @brief Try and get a component from the system.
+		 * This is useful when accessing optional components of a query.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr Component* The component pointer. This will be nullptr if the entity is not registered to the component.
+		 */
+		template <class Component>
+			requires std::is_reference_v<typename system_type<Component>::reference>
+		constexpr INV_NODISCARD Component *try_get_component(const entity_index_type index) { return try_get_component<Component>(get_entity(index)); }
+
+		/**
+		 * @brief Try and get a component from the system.
+		 * This is useful when accessing optional components of a query.
+		 *
+		 * @tparam Component The component type.
+		 * @param index The entity index.
+		 * @return constexpr const Component* The component pointer. This will be nullptr if the entity is not registered to the component.
 		 */
 		template <class Component>
-		constexpr INV_NODISCARD const Component &get_component(const entity_type &ent) const { return get_system<Component>().get(ent); }
+			requires std::is_reference_v<typename system_type<Component>::reference>
+		constexpr INV_NODISCARD const Component *try_get_component(const entity_index_type index) const { return try_get_component<Component>(get_entity(index)); }
+
+		/**
+		 * @brief Modify an entity's component.
+		 * The function is called with the component reference, and the component is marked as changed in the current tick if it tracks changes.
+		 *
+		 * @tparam Component The component type.
+		 * @tparam Function The function type.
+		 * @param index The entity index.
+		 * @param function The function which modifies the component.
+		 * @return constexpr decltype(auto) The component reference.
+		 */
+		template <class Component, class Function>
+		constexpr decltype(auto) patch(const entity_index_type index, Function &&function)
+		{
+			const auto &ent = get_entity(index);
+			auto &system = get_system<Component>();
+			function(system.get(ent));
+
+			if constexpr (tracked_component<Component>)
+				system.mark_changed(ent, m_CurrentTick);
+
+			return system.get(ent);
+		}
+
+		/**
+		 * @brief Mark an entity's component as changed in the current tick.
+		 * Accessing a component does not update the ticks, so this must be called after a tracked component is modified through get_component(), each() or the system.
+		 *
+		 * @tparam Component The component type. This must have change tracking enabled.
+		 * @param index The entity index.
+		 */
+		template <tracked_component Component>
+		constexpr void mark_changed(const entity_index_type index) { get_system<Component>().mark_changed(get_entity(index), m_CurrentTick); }
+
+		/**
+		 * @brief Get the current change tick.
+		 * Components which are added or changed are stamped with this tick.
+		 *
+		 * @return constexpr uint64_t The current tick.
+		 */
+		constexpr INV_NODISCARD uint64_t current_tick() const noexcept { return m_CurrentTick; }
+
+		/**
+		 * @brief Advance the change tick.
+		 * Incremental passes can store the returned tick after they run, and pass it to the next query so that only the components which were added or changed in
+		 * the meantime are selected.
+		 *
+		 * @code
+		 * for (auto [entity, transform] : registry.each<transform_component, inventory::changed<transform_component>>(m_LastTick))
+		 *     ...
+		 *
+		 * m_LastTick = registry.advance_tick();
+		 * @endcode
+		 *
+		 * @return constexpr uint64_t The tick before advancing.
+		 */
+		constexpr uint64_t advance_tick() noexcept { return m_CurrentTick++; }
+
+		/**
+		 * @brief Get an owning group of components.
+		 * The group keeps the first few components of all the owned systems aligned to the entities which have all the owned components, and the registry maintains
+		 * the alignment as the components are registered and unregistered. The group is created (and the existing entities are moved into it) the first time this is
+		 * called. A component can only be owned by a single group, and the owned systems must not be sorted or modified directly while the group exists.
+		 *
+		 * @code
+		 * for (auto [entity, position, velocity] : registry.group<position_component, velocity_component>())
+		 *     position += velocity;
+		 * @endcode
+		 *
+		 * @tparam Owned The owned components. Tags cannot be owned.
+		 * @return decltype(auto) The group object.
+		 */
+		template <class... Owned>
+		INV_NODISCARD decltype(auto) group()
+		{
+			static_assert(sizeof...(Owned) > 1, "A group must own at least two components!");
+			static_assert(!(tag_component<Owned> || ...), "Tag components cannot be owned by a group!");
+
+			mask_type owned;
+			(owned.toggle_true(get_component_index<Owned, Components...>()), ...);
+
+			auto itr = std::find_if(m_Groups.begin(), m_Groups.end(), [owned](const owning_group &owningGroup)
+									{ return owningGroup.m_Owned == owned; });
+
+			if (itr == m_Groups.end())
+			{
+				if (std::any_of(m_Groups.begin(), m_Groups.end(), [owned](const owning_group &owningGroup)
+								{ return owningGroup.m_Owned.intersects(owned); }))
+					throw group_ownership_error("A component can only be owned by a single group. Make sure that the owned components of the groups do not overlap.");
+
+				auto &owningGroup = m_Groups.emplace_back(owned, 0, &move_to_group_position<Owned...>);
+
+				// Move the entities which already have all the owned components into the group. The matching entities are always moved behind the current position.
+				auto &first = get_system<std::tuple_element_t<0, std::tuple<Owned...>>>();
+				for (uint64_t position = 0; position < first.size(); position++)
+				{
+					const auto &entity = get_entity(first.owner_of(position));
+					if (entity.get_bits().contains(owned))
+						move_to_group_position<Owned...>(*this, entity, owningGroup.m_Length++);
+				}
+
+				itr = std::prev(m_Groups.end());
+			}
+
+			return inventory::group<system_type<Owned>...>(itr->m_Length, get_system<Owned>()...);
+		}
 
 	public:
 		/**
@@ -309,25 +781,204 @@ namespace inventory
 		template <class Component>
 		static consteval INV_NODISCARD decltype(auto) component_index() { return get_component_index<Component, Components...>(); }
 
+		/**
+		 * @brief Check if a selected type of a query only filters using the entity bits.
+		 * Tags and the exclude and optional filters does not have any owners to iterate, unlike the components and the added and changed filters.
+		 *
+		 * @tparam Type The selected type.
+		 * @return true if the type only filters using the entity bits.
+		 * @return false if the type has owners which can be iterated.
+		 */
+		template <class Type>
+		static consteval INV_NODISCARD bool is_bit_filter() { return (tag_component<Type> || query_filter<Type>) && !change_filter<Type>; }
+
+		/**
+		 * @brief Add a selected type of a query to the query masks.
+		 * Components (including the components of the added and changed filters) are added to the required mask, excluded components are added to the excluded mask
+		 * and optional components are ignored as they does not filter.
+		 *
+		 * @tparam Type The selected type.
+		 * @param required The required component mask.
+		 * @param excluded The excluded component mask.
+		 */
+		template <class Type>
+		static constexpr void add_to_query_masks(mask_type &required, mask_type &excluded)
+		{
+			if constexpr (is_exclude_filter<Type>::value)
+				[]<class... Excluded>(mask_type &mask, exclude<Excluded...>)
+				{ (mask.toggle_true(component_index<Excluded>()), ...); }(excluded, Type());
+
+			else if constexpr (change_filter<Type>)
+				[]<template <class...> class Filter, class... Tracked>(mask_type &mask, Filter<Tracked...>)
+				{ (mask.toggle_true(component_index<Tracked>()), ...); }(required, Type());
+
+			else if constexpr (!is_optional_filter<Type>::value)
+				required.toggle_true(component_index<Type>());
+		}
+
+		/**
+		 * @brief Select the owning entities of a component's system if it's smaller than the currently selected entities.
+		 * Tag components are skipped as they does not keep track of their owners. The components of the added and changed filters are selected the same way.
+		 *
+		 * @tparam Component The component type.
+		 * @param smallest The currently selected entities.
+		 * @param isFirst Whether nothing has been selected yet.
+		 */
+		template <class Component>
+		constexpr void select_smallest_entity_set(std::span<const entity_index_type> &smallest, bool &isFirst) const
+		{
+			if constexpr (change_filter<Component>)
+				[]<template <class...> class Filter, class... Tracked>(const basic_registry &registry, std::span<const entity_index_type> &entities, bool &first, Filter<Tracked...>)
+				{ (registry.select_smallest_entity_set<Tracked>(entities, first), ...); }(*this, smallest, isFirst, Component());
+
+			else if constexpr (!tag_component<Component> && !query_filter<Component>)
+			{
+				const auto entities = get_system<Component>().entities();
+				if (isFirst || entities.size() < smallest.size())
+				{
+					smallest = entities;
+					isFirst = false;
+				}
+			}
+		}
+
+		/**
+		 * @brief Get the owning entities of the smallest system from the selected components.
+		 * Queries iterate these entities and probe the rest of the components using the entity bits, so the query cost scales with the rarest component.
+		 *
+		 * @tparam Selection The selected components.
+		 * @return constexpr std::span<const entity_index_type> The entity indexes.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD std::span<const entity_index_type> get_smallest_entity_set() const
+		{
+			std::span<const entity_index_type> smallest;
+			bool isFirst = true;
+			(select_smallest_entity_set<Selection>(smallest, isFirst), ...);
+
+			return smallest;
+		}
+
+		/**
+		 * @brief Get the entities which should be iterated by a query.
+		 * If the required components are cached, the cached entities are returned. Otherwise the owning entities of the smallest system is returned.
+		 *
+		 * @tparam Selection The selected components.
+		 * @param required The required component mask.
+		 * @return constexpr std::span<const entity_index_type> The entity indexes.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD std::span<const entity_index_type> get_entity_set(const mask_type &required) const
+		{
+			if (const auto pEntities = m_Cache.find(required))
+				return std::span<const entity_index_type>(pEntities->begin(), pEntities->end());
+
+			return get_smallest_entity_set<Selection...>();
+		}
+
 	public:
+		/**
+		 * @brief Cache the entities of a query.
+		 * The cached entity list is updated when entities are registered to or unregistered from systems, and queries with the same required components iterate the
+		 * cached list instead of searching for the entities.
+		 *
+		 * @tparam Selection The required components. Filters can be passed, but only the required components are cached.
+		 */
+		template <class... Selection>
+		void cache_query()
+		{
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			if (m_Cache.contains(required))
+				return;
+
+			auto &entities = m_Cache.register_sequence(required);
+			for (uint64_t position = 0; position < m_Entities.size(); position++)
+			{
+				if (m_Entities.begin()[position].get_bits().contains(required))
+					[[maybe_unused]] const auto result = entities.insert(m_Entities.index_of(position));
+			}
+		}
+
+		/**
+		 * @brief Remove a cached query.
+		 *
+		 * @tparam Selection The required components.
+		 */
+		template <class... Selection>
+		void uncache_query()
+		{
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			m_Cache.unregister_sequence(required);
+		}
+
+		/**
+		 * @brief Check if a query is cached.
+		 *
+		 * @tparam Selection The required components.
+		 * @return true if the query is cached.
+		 * @return false if the query is not cached.
+		 */
+		template <class... Selection>
+		INV_NODISCARD bool is_query_cached() const
+		{
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			return m_Cache.contains(required);
+		}
+
 		/**
 		 * @brief Get the query for the required components.
+		 * The selection can contain exclude<...> filters to skip the entities which are registered to the given components, and optional<...> filters to mark
+		 * components which may not be present (use try_get_component() to access them). Both the filters are evaluated in the same bit set test as the required components.
+		 * The added<...> and changed<...> filters select the components which were added or changed in the current tick.
 		 *
-		 * @tparam Selection The required components.1
+		 * @tparam Selection The required components and the filters.
 		 * @return constexpr decltype(auto) The query.
 		 */
 		template <class... Selection>
-		constexpr INV_NODISCARD decltype(auto) query()
+		constexpr INV_NODISCARD decltype(auto) query() { return query<Selection...>(m_CurrentTick - 1); }
+
+		/**
+		 * @brief Get the query for the required components.
+		 * The selection can contain exclude<...> filters to skip the entities which are registered to the given components, and optional<...> filters to mark
+		 * components which may not be present (use try_get_component() to access them). Both the filters are evaluated in the same bit set test as the required components.
+		 * The added<...> and changed<...> filters select the components which were added or changed after the given tick, and are checked after the bit set test.
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @param since The tick used by the added and changed filters.
+		 * @return constexpr decltype(auto) The query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) query(const uint64_t since)
 		{
-			if constexpr (sizeof...(Selection) == 1)
+			if constexpr (sizeof...(Selection) == 1 && !((tag_component<Selection> || query_filter<Selection> || change_filter<Selection>) && ...))
 				return get_system<Selection...>();
 
-			else if constexpr (sizeof...(Selection) > 1)
+			else if constexpr (sizeof...(Selection) > 0)
 			{
-				bit_set<get_component_count<Components...>()> bitset;
-				(bitset.toggle_true(component_index<Selection>()), ...);
+				mask_type required;
+				mask_type excluded;
+				(add_to_query_masks<Selection>(required, excluded), ...);
+
+				// Tags does not know their owners, so we need to scan the masks of all the entities.
+				if constexpr ((is_bit_filter<Selection>() && ...))
+					return mask_query(m_Entities, m_Masks, required, excluded);
+
+				else
+				{
+					using iterator_type = entity_index_iterator<entity_container_type, typename std::span<const entity_index_type>::iterator>;
 
-				return ::inventory::query(begin(), end(), bitset);
+					const auto owners = get_entity_set<Selection...>(required);
+					return ::inventory::query(iterator_type(m_Entities, owners.begin()), iterator_type(m_Entities, owners.end()), required, excluded, std::tuple_cat(create_query_filters<Selection>(*this, since)...));
+				}
 			}
 
 			else
@@ -336,35 +987,227 @@ namespace inventory
 
 		/**
 		 * @brief Get the query for the required components.
+		 * The selection can contain exclude<...> filters to skip the entities which are registered to the given components, and optional<...> filters to mark
+		 * components which may not be present (use try_get_component() to access them). Both the filters are evaluated in the same bit set test as the required components.
+		 * The added<...> and changed<...> filters select the components which were added or changed in the current tick.
 		 *
-		 * @tparam Selection The required components.
+		 * @tparam Selection The required components and the filters.
+		 * @return constexpr decltype(auto) The const query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) query() const { return query<Selection...>(m_CurrentTick - 1); }
+
+		/**
+		 * @brief Get the query for the required components.
+		 * The selection can contain exclude<...> filters to skip the entities which are registered to the given components, and optional<...> filters to mark
+		 * components which may not be present (use try_get_component() to access them). Both the filters are evaluated in the same bit set test as the required components.
+		 * The added<...> and changed<...> filters select the components which were added or changed after the given tick, and are checked after the bit set test.
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @param since The tick used by the added and changed filters.
 		 * @return constexpr decltype(auto) The const query.
 		 */
 		template <class... Selection>
-		constexpr INV_NODISCARD decltype(auto) query() const
+		constexpr INV_NODISCARD decltype(auto) query(const uint64_t since) const
 		{
-			if constexpr (sizeof...(Selection) == 1)
+			if constexpr (sizeof...(Selection) == 1 && !((tag_component<Selection> || query_filter<Selection> || change_filter<Selection>) && ...))
 				return get_system<Selection...>();
 
-			else if constexpr (sizeof...(Selection) > 1)
+			else if constexpr (sizeof...(Selection) > 0)
 			{
-				bit_set<get_component_count<Components...>()> bitset;
-				(bitset.toggle_true(component_index<Selection>()), ...);
+				mask_type required;
+				mask_type excluded;
+				(add_to_query_masks<Selection>(required, excluded), ...);
+
+				// Tags does not know their owners, so we need to scan the masks of all the entities.
+				if constexpr ((is_bit_filter<Selection>() && ...))
+					return mask_query(m_Entities, m_Masks, required, excluded);
 
-				return ::inventory::const_query(begin(), end(), bitset);
+				else
+				{
+					using iterator_type = entity_index_iterator<const entity_container_type, typename std::span<const entity_index_type>::iterator>;
+
+					const auto owners = get_entity_set<Selection...>(required);
+					return ::inventory::const_query(iterator_type(m_Entities, owners.begin()), iterator_type(m_Entities, owners.end()), required, excluded, std::tuple_cat(create_query_filters<Selection>(*this, since)...));
+				}
 			}
 
 			else
 				return *this;
 		}
 
+		/**
+		 * @brief Get a component query which yields a tuple containing the entity index followed by the references of the selected components.
+		 * The selection accepts the same filters as query(). Tag components and excluded components are only used to filter, and optional components are yielded as
+		 * pointers which are null when the entity is not registered to the component (optional tags are yielded as a boolean). At least one of the required components must not be a tag.
+		 * The added<...> and changed<...> filters select the components which were added or changed in the current tick.
+		 *
+		 * @code
+		 * for (auto [entity, model, camera] : registry.each<model_component, camera_component>())
+		 * @endcode
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @return constexpr decltype(auto) The component query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) each() { return each<Selection...>(m_CurrentTick - 1); }
+
+		/**
+		 * @brief Get a component query which yields a tuple containing the entity index followed by the references of the selected components.
+		 * This is the same as each(), but the added<...> and changed<...> filters select the components which were added or changed after the given tick.
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @param since The tick used by the added and changed filters.
+		 * @return constexpr decltype(auto) The component query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) each(const uint64_t since)
+		{
+			static_assert(!(is_bit_filter<Selection>() && ...), "At least one of the required components must not be a tag!");
+
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			const auto owners = get_entity_set<Selection...>(required);
+			return component_query(m_Entities, owners.begin(), owners.end(), required, excluded, std::tuple_cat(create_component_accessors<Selection>(*this)...), std::tuple_cat(create_query_filters<Selection>(*this, since)...));
+		}
+
+		/**
+		 * @brief Get a component query which yields a tuple containing the entity index followed by the references of the selected components.
+		 * The selection accepts the same filters as query(). Tag components and excluded components are only used to filter, and optional components are yielded as
+		 * pointers which are null when the entity is not registered to the component (optional tags are yielded as a boolean). At least one of the required components must not be a tag.
+		 * The added<...> and changed<...> filters select the components which were added or changed in the current tick.
+		 *
+		 * @code
+		 * for (auto [entity, model, camera] : registry.each<model_component, camera_component>())
+		 * @endcode
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @return constexpr decltype(auto) The const component query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) each() const { return each<Selection...>(m_CurrentTick - 1); }
+
+		/**
+		 * @brief Get a component query which yields a tuple containing the entity index followed by the references of the selected components.
+		 * This is the same as each(), but the added<...> and changed<...> filters select the components which were added or changed after the given tick.
+		 *
+		 * @tparam Selection The required components and the filters.
+		 * @param since The tick used by the added and changed filters.
+		 * @return constexpr decltype(auto) The const component query.
+		 */
+		template <class... Selection>
+		constexpr INV_NODISCARD decltype(auto) each(const uint64_t since) const
+		{
+			static_assert(!(is_bit_filter<Selection>() && ...), "At least one of the required components must not be a tag!");
+
+			mask_type required;
+			mask_type excluded;
+			(add_to_query_masks<Selection>(required, excluded), ...);
+
+			const auto owners = get_entity_set<Selection...>(required);
+			return component_query(m_Entities, owners.begin(), owners.end(), required, excluded, std::tuple_cat(create_component_accessors<Selection>(*this)...), std::tuple_cat(create_query_filters<Selection>(*this, since)...));
+		}
+
+	private:
+		/**
+		 * @brief Create the component accessors of a selected type of a component query.
+		 * Tags, excluded components and the added and changed filters does not create any accessors as they are only used to filter.
+		 *
+		 * @tparam Type The selected type.
+		 * @tparam Self The registry type. This can be const qualified.
+		 * @param self The registry.
+		 * @return constexpr decltype(auto) The tuple of accessors.
+		 */
+		template <class Type, class Self>
+		static constexpr INV_NODISCARD decltype(auto) create_component_accessors(Self &self)
+		{
+			if constexpr (is_optional_filter<Type>::value)
+				return []<class... Optional>(Self &registry, optional<Optional...>)
+				{ return std::tuple(optional_component_accessor(registry.template get_system<Optional>())...); }(self, Type());
+
+			else if constexpr (tag_component<Type> || is_exclude_filter<Type>::value || change_filter<Type>)
+				return std::tuple<>();
+
+			else
+				return std::tuple(required_component_accessor(self.template get_system<Type>()));
+		}
+
+		/**
+		 * @brief Create the query filters of a selected type of a query.
+		 * Only the added and changed filters create query filters, which check the ticks of their components.
+		 *
+		 * @tparam Type The selected type.
+		 * @param self The registry.
+		 * @param since The tick to compare against.
+		 * @return constexpr decltype(auto) The tuple of filters.
+		 */
+		template <class Type>
+		static constexpr INV_NODISCARD decltype(auto) create_query_filters(const basic_registry &self, const uint64_t since)
+		{
+			if constexpr (change_filter<Type>)
+				return []<template <class...> class Filter, class... Tracked>(const basic_registry &registry, const uint64_t tick, Filter<Tracked...>)
+				{
+					static_assert((tracked_component<Tracked> && ...), "The added and changed filters require components with change tracking enabled!");
+					return std::tuple(tick_filter<system_type<Tracked>, is_added_filter<Type>::value>(registry.template get_system<Tracked>(), tick)...);
+				}(self, since, Type());
+
+			else
+				return std::tuple<>();
+		}
+
+		/**
+		 * @brief Create a callback container using an allocator.
+		 *
+		 * @tparam Indexes The callback array indexes.
+		 * @param allocator The allocator to use.
+		 * @return callback_container The created container.
+		 */
+		template <std::size_t... Indexes>
+		static INV_NODISCARD callback_container create_callback_container(const Allocator &allocator, [[maybe_unused]] std::index_sequence<Indexes...> sequence)
+		{
+			return {((void)Indexes, callback_array(rebind_allocator<callback_type>(allocator)))...};
+		}
+
 	private:
+		/**
+		 * @brief Owning group data structure.
+		 * This stores the components owned by a group, the number of entities in the group, and a function which moves an entity to a given position of all the owned
+		 * systems.
+		 */
+		struct owning_group final
+		{
+			mask_type m_Owned;
+			uint64_t m_Length = 0;
+			void (*m_pMove)(basic_registry &, const entity_type &, uint64_t) = nullptr;
+		};
+
+		using group_container = std::deque<owning_group, rebind_allocator<owning_group>>;
+
 		system_container_type m_Systems;
 		entity_container_type m_Entities;
 		callback_container m_RegisterCallbacks;
 		callback_container m_UnregisterCallbacks;
+		cache_type m_Cache;
+		mask_column_type m_Masks;
+		group_container m_Groups;
+		generation_container m_Generations;
+
+		uint64_t m_CurrentTick = 1;
 	};
 
+	/**
+	 * @brief Registry type.
+	 * This type is a basic registry which uses the standard allocator.
+	 *
+	 * @tparam EntityIndex The entity index type. Default is default_index_type.
+	 * @tparam ComponentIndex The component index type. Default is default_index_type.
+	 * @tparam Components The components to store in the registry.
+	 */
+	template <index_type EntityIndex = default_index_type, index_type ComponentIndex = default_index_type, class... Components>
+	using registry = basic_registry<EntityIndex, ComponentIndex, std::allocator<std::byte>, dense_entity_layout, Components...>;
+
 	/**
 	 * @brief Default registry type.
 	 * This type is just a registry with the entity and component index types begin the default index type.
@@ -373,4 +1216,24 @@ namespace inventory
 	 */
 	template <class... Components>
 	using default_registry = registry<default_index_type, default_index_type, Components...>;
+
+	/**
+	 * @brief Polymorphic memory resource registry type.
+	 * This registry allocates all of its memory from a std::pmr::memory_resource, which allows a whole world to be backed by an arena (like the
+	 * std::pmr::monotonic_buffer_resource) or a pool and released in one shot.
+	 *
+	 * @tparam Components The components.
+	 */
+	template <class... Components>
+	using pmr_registry = basic_registry<default_index_type, default_index_type, std::pmr::polymorphic_allocator<std::byte>, dense_entity_layout, Components...>;
+
+	/**
+	 * @brief Compact registry type.
+	 * This registry uses the compact entity layout, where every entity only stores the indexes of the components attached to it. This is useful for registries with
+	 * a large number of components where entities only use a few of them.
+	 *
+	 * @tparam Components The components.
+	 */
+	template <class... Components>
+	using compact_registry = basic_registry<default_index_type, default_index_type, std::allocator<std::byte>, compact_entity_layout, Components...>;
 } // namespace inventory
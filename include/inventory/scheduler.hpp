@@ -0,0 +1,273 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "registry.hpp"
+#include "task_access.hpp"
+#include "thread_pool.hpp"
+
+#include <exception>
+#include <latch>
+#include <utility>
+
+namespace inventory
+{
+	/**
+	 * @brief Scheduler class.
+	 * This is specialized for the basic registry.
+	 *
+	 * @tparam Registry The registry type.
+	 */
+	template <class Registry>
+	class scheduler;
+
+	/**
+	 * @brief Scheduler class.
+	 * The scheduler runs a list of tasks over a registry. Every task declares the components it reads and writes, and the scheduler builds a dependency graph from
+	 * them. Tasks which conflict (where one writes a component which is read or written by the other) are run in the order they were added, and all the other tasks
+	 * are run concurrently on a work-stealing thread pool.
+	 *
+	 * Tasks which do not declare any access are treated as exclusive, and are used for work which changes the structure of the registry (like creating entities or
+	 * registering components). These never run alongside another task. Tasks which only read components are given a const registry, so that they cannot modify
+	 * the registry while other readers are running.
+	 *
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam ComponentIndex The component index type.
+	 * @tparam Allocator The allocator type.
+	 * @tparam Layout The entity layout policy.
+	 * @tparam Components The components of the registry.
+	 */
+	template <index_type EntityIndex, index_type ComponentIndex, class Allocator, class Layout, class... Components>
+	class scheduler<basic_registry<EntityIndex, ComponentIndex, Allocator, Layout, Components...>> final
+	{
+	public:
+		using registry_type = basic_registry<EntityIndex, ComponentIndex, Allocator, Layout, Components...>;
+		using function_type = std::function<void(registry_type &)>;
+
+	private:
+		using mask_type = bit_set<get_component_count<Components...>()>;
+
+		/**
+		 * @brief Task structure.
+		 */
+		struct task final
+		{
+			function_type m_Function;
+			mask_type m_Read;
+			mask_type m_Write;
+			std::vector<uint64_t> m_Dependents;
+			uint64_t m_DependencyCount = 0;
+			bool m_IsExclusive = false;
+		};
+
+		/**
+		 * @brief Run state structure.
+		 * This is shared between all the tasks of a single run.
+		 */
+		struct run_state final
+		{
+			explicit run_state(const uint64_t taskCount) : m_pDependencyCounts(std::make_unique<std::atomic<uint64_t>[]>(taskCount)), m_Latch(static_cast<std::ptrdiff_t>(taskCount)) {}
+
+			std::unique_ptr<std::atomic<uint64_t>[]> m_pDependencyCounts;
+			std::latch m_Latch;
+
+			std::mutex m_ExceptionMutex;
+			std::exception_ptr m_Exception;
+			std::atomic<bool> m_HasFailed = false;
+		};
+
+		std::vector<task> m_Tasks;
+		thread_pool m_Pool;
+
+	public:
+		/**
+		 * @brief Construct a new scheduler object.
+		 *
+		 * @param threadCount The number of worker threads. Default is the number of hardware threads.
+		 */
+		explicit scheduler(const uint64_t threadCount = std::thread::hardware_concurrency()) : m_Pool(threadCount) {}
+
+		/**
+		 * @brief Add a new task to the scheduler.
+		 * The task will depend on all the previously added tasks which conflict with it.
+		 *
+		 * Example: scheduler.add_task<reads<velocity>, writes<position>>([](auto &registry) { ... });
+		 *
+		 * @tparam Accesses The read and write accesses of the task.
+		 * @tparam Function The function type.
+		 * @param function The task function. This is called with the registry, which is const if the task only reads components.
+		 * @return uint64_t The task index.
+		 */
+		template <task_access... Accesses, class Function>
+		uint64_t add_task(Function &&function)
+		{
+			constexpr auto readMask = create_access_mask<is_read_access, Accesses...>();
+			constexpr auto writeMask = create_access_mask<is_write_access, Accesses...>();
+			constexpr auto isReadOnly = sizeof...(Accesses) > 0 && !(is_write_access<Accesses>::value || ...);
+
+			task newTask;
+			if constexpr (isReadOnly)
+				newTask.m_Function = [function = std::forward<Function>(function)](registry_type &registry) mutable
+				{ function(std::as_const(registry)); };
+
+			else
+				newTask.m_Function = std::forward<Function>(function);
+
+			newTask.m_Read = readMask;
+			newTask.m_Write = writeMask;
+			newTask.m_IsExclusive = sizeof...(Accesses) == 0;
+
+			const auto index = m_Tasks.size();
+			for (uint64_t i = 0; i < index; i++)
+			{
+				if (is_conflicting(m_Tasks[i], newTask))
+				{
+					m_Tasks[i].m_Dependents.emplace_back(index);
+					newTask.m_DependencyCount++;
+				}
+			}
+
+			m_Tasks.emplace_back(std::move(newTask));
+			return index;
+		}
+
+		/**
+		 * @brief Check if a task must run after another task.
+		 *
+		 * @param index The task index.
+		 * @param other The index of the other task, which must be added before the task.
+		 * @return true if the task directly depends on the other task.
+		 * @return false if the task does not directly depend on the other task.
+		 */
+		INV_NODISCARD bool depends_on(const uint64_t index, const uint64_t other) const
+		{
+			const auto &dependents = m_Tasks[other].m_Dependents;
+			return std::find(dependents.begin(), dependents.end(), index) != dependents.end();
+		}
+
+		/**
+		 * @brief Run all the tasks and wait till they are finished.
+		 * If a task throws, the tasks which were not started yet are skipped and the first exception is rethrown. This must not be called from within a task.
+		 *
+		 * @param registry The registry to run the tasks on.
+		 */
+		void run(registry_type &registry)
+		{
+			if (m_Tasks.empty())
+				return;
+
+			auto pState = std::make_shared<run_state>(m_Tasks.size());
+			for (uint64_t i = 0; i < m_Tasks.size(); i++)
+				pState->m_pDependencyCounts[i] = m_Tasks[i].m_DependencyCount;
+
+			for (uint64_t i = 0; i < m_Tasks.size(); i++)
+			{
+				if (m_Tasks[i].m_DependencyCount == 0)
+					submit(pState, registry, i);
+			}
+
+			pState->m_Latch.wait();
+
+			if (pState->m_Exception)
+				std::rethrow_exception(pState->m_Exception);
+		}
+
+		/**
+		 * @brief Get the number of tasks.
+		 *
+		 * @return uint64_t The task count.
+		 */
+		INV_NODISCARD uint64_t size() const noexcept { return m_Tasks.size(); }
+
+		/**
+		 * @brief Remove all the tasks.
+		 */
+		void clear() { m_Tasks.clear(); }
+
+	private:
+		/**
+		 * @brief Create the component mask of a list of accesses.
+		 *
+		 * @tparam Trait The access trait used to select the accesses.
+		 * @tparam Accesses The accesses.
+		 * @return consteval mask_type The mask.
+		 */
+		template <template <class> class Trait, class... Accesses>
+		static consteval INV_NODISCARD mask_type create_access_mask()
+		{
+			mask_type mask;
+			(add_to_access_mask<Trait>(mask, static_cast<Accesses *>(nullptr)), ...);
+
+			return mask;
+		}
+
+		/**
+		 * @brief Add the components of an access to a mask.
+		 *
+		 * @tparam Trait The access trait used to select the accesses.
+		 * @tparam Access The access type.
+		 * @tparam Types The components of the access.
+		 * @param mask The mask to add the components to.
+		 */
+		template <template <class> class Trait, template <class...> class Access, class... Types>
+		static constexpr void add_to_access_mask(mask_type &mask, Access<Types...> *)
+		{
+			if constexpr (Trait<Access<Types...>>::value)
+				(mask.toggle_true(get_component_index<Types, Components...>()), ...);
+		}
+
+		/**
+		 * @brief Check if two tasks conflict with each other.
+		 * Writes also count as reads, so two tasks conflict if one of them writes a component that the other one uses.
+		 *
+		 * @param first The first task.
+		 * @param second The second task.
+		 * @return true if the tasks conflict.
+		 * @return false if the tasks can run concurrently.
+		 */
+		static INV_NODISCARD bool is_conflicting(const task &first, const task &second)
+		{
+			if (first.m_IsExclusive || second.m_IsExclusive)
+				return true;
+
+			return first.m_Write.intersects(second.m_Read) || first.m_Write.intersects(second.m_Write) || second.m_Write.intersects(first.m_Read);
+		}
+
+		/**
+		 * @brief Submit a task to the thread pool.
+		 * Once the task is finished, the dependents which no longer have any pending dependencies are submitted from the same worker.
+		 *
+		 * @param pState The run state.
+		 * @param registry The registry to run the task on.
+		 * @param index The task index.
+		 */
+		void submit(const std::shared_ptr<run_state> &pState, registry_type &registry, const uint64_t index)
+		{
+			m_Pool.submit([this, pState, &registry, index]
+						  {
+							  if (!pState->m_HasFailed)
+							  {
+								  try
+								  {
+									  m_Tasks[index].m_Function(registry);
+								  }
+								  catch (...)
+								  {
+									  std::lock_guard lock(pState->m_ExceptionMutex);
+									  if (!pState->m_Exception)
+										  pState->m_Exception = std::current_exception();
+
+									  pState->m_HasFailed = true;
+								  }
+							  }
+
+							  for (const auto dependent : m_Tasks[index].m_Dependents)
+							  {
+								  if (--pState->m_pDependencyCounts[dependent] == 0)
+									  submit(pState, registry, dependent);
+							  }
+
+							  pState->m_Latch.count_down(); });
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,605 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Member pointer traits generalized type.
+	 *
+	 * @tparam MemberPointer The member pointer type.
+	 */
+	template <class MemberPointer>
+	struct member_pointer_traits;
+
+	/**
+	 * @brief Member pointer traits specialized type.
+	 *
+	 * @tparam Class The class type.
+	 * @tparam Member The member type.
+	 */
+	template <class Class, class Member>
+	struct member_pointer_traits<Member Class::*> final
+	{
+		using class_type = Class;
+		using member_type = Member;
+	};
+
+	/**
+	 * @brief Member type alias.
+	 * This resolves the type of a data member using its member pointer.
+	 *
+	 * @tparam Member The member pointer.
+	 */
+	template <auto Member>
+	using member_type = typename member_pointer_traits<decltype(Member)>::member_type;
+
+	/**
+	 * @brief Get the position of a member pointer in a list of member pointers.
+	 * If an integral value is given, it is returned as is.
+	 *
+	 * @tparam Member The member pointer (or the position) to look for.
+	 * @tparam Members The member pointers.
+	 * @return consteval uint64_t The position.
+	 */
+	template <auto Member, auto... Members>
+	consteval INV_NODISCARD uint64_t get_member_index()
+	{
+		if constexpr (std::is_integral_v<decltype(Member)>)
+			return Member;
+
+		else
+		{
+			uint64_t index = 0;
+			bool found = false;
+			([&found, &index]
+			 {
+				 if constexpr (std::is_same_v<decltype(Member), decltype(Members)>)
+					 found = found || Member == Members;
+
+				 if (!found)
+					 index++; }(),
+			 ...);
+
+			return index;
+		}
+	}
+
+	/**
+	 * @brief Structure of arrays reference.
+	 * This is a proxy which references a single element stored in a soa_vector. Each member can be accessed using get<>().
+	 *
+	 * @tparam Type The aggregate type.
+	 * @tparam Const Whether the referenced members are const.
+	 * @tparam Members The member pointers.
+	 */
+	template <class Type, bool Const, auto... Members>
+	class soa_reference final
+	{
+		template <auto Member>
+		using field_reference = std::conditional_t<Const, const member_type<Member> &, member_type<Member> &>;
+
+		std::tuple<field_reference<Members>...> m_Fields;
+
+		template <class, bool, auto...>
+		friend class soa_reference;
+
+	public:
+		/**
+		 * @brief Construct a new soa reference object.
+		 *
+		 * @param fields The field references.
+		 */
+		constexpr explicit soa_reference(field_reference<Members>... fields) : m_Fields(fields...) {}
+
+		/**
+		 * @brief Conversion constructor from a mutable reference to a const reference.
+		 *
+		 * @param other The other reference.
+		 */
+		template <bool OtherConst>
+		requires(Const && !OtherConst) constexpr soa_reference(const soa_reference<Type, OtherConst, Members...> &other) : m_Fields(other.m_Fields) {}
+
+		/**
+		 * @brief Copy constructor.
+		 * This copies the reference, not the referenced values.
+		 *
+		 * @param other The other reference.
+		 */
+		constexpr soa_reference(const soa_reference &other) = default;
+
+		/**
+		 * @brief Copy assignment operator.
+		 * This copies the referenced values of the other element to this element.
+		 *
+		 * @param other The other reference.
+		 * @return constexpr const soa_reference& This reference.
+		 */
+		constexpr const soa_reference &operator=(const soa_reference &other) const
+		{
+			assign(other, std::index_sequence_for<decltype(Members)...>());
+			return *this;
+		}
+
+		/**
+		 * @brief Move assignment operator.
+		 * This moves the referenced values of the other element to this element.
+		 *
+		 * @param other The other reference.
+		 * @return constexpr const soa_reference& This reference.
+		 */
+		constexpr const soa_reference &operator=(soa_reference &&other) const
+		{
+			move_assign(other, std::index_sequence_for<decltype(Members)...>());
+			return *this;
+		}
+
+		/**
+		 * @brief Assign an aggregate value to the referenced element.
+		 *
+		 * @param value The value to assign.
+		 * @return constexpr const soa_reference& This reference.
+		 */
+		constexpr const soa_reference &operator=(const Type &value) const
+		{
+			((get<Members>() = value.*Members), ...);
+			return *this;
+		}
+
+		/**
+		 * @brief Get a member of the referenced element.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The member reference.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) get() const { return std::get<get_member_index<Member, Members...>()>(m_Fields); }
+
+		/**
+		 * @brief Assemble a copy of the referenced element.
+		 *
+		 * @return Type The copied element.
+		 */
+		constexpr INV_NODISCARD operator Type() const
+		{
+			Type value = {};
+			((value.*Members = get<Members>()), ...);
+			return value;
+		}
+
+	private:
+		/**
+		 * @brief Copy all the fields of another element to this element.
+		 *
+		 * @tparam Indexes The field indexes.
+		 * @param other The other reference.
+		 */
+		template <std::size_t... Indexes>
+		constexpr void assign(const soa_reference &other, [[maybe_unused]] std::index_sequence<Indexes...> sequence) const { ((std::get<Indexes>(m_Fields) = std::get<Indexes>(other.m_Fields)), ...); }
+
+		/**
+		 * @brief Move all the fields of another element to this element.
+		 *
+		 * @tparam Indexes The field indexes.
+		 * @param other The other reference.
+		 */
+		template <std::size_t... Indexes>
+		constexpr void move_assign(const soa_reference &other, [[maybe_unused]] std::index_sequence<Indexes...> sequence) const { ((std::get<Indexes>(m_Fields) = std::move(std::get<Indexes>(other.m_Fields))), ...); }
+	};
+
+	/**
+	 * @brief Structure of arrays vector iterator.
+	 * Dereferencing this iterator returns a soa_reference to the current element.
+	 *
+	 * @tparam Container The soa_vector type. This could be const qualified for a const iterator.
+	 */
+	template <class Container>
+	class soa_vector_iterator final
+	{
+		Container *m_pContainer = nullptr;
+		uint64_t m_Index = 0;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename Container::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<std::is_const_v<Container>, typename Container::const_reference, typename Container::reference>;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr soa_vector_iterator() = default;
+
+		/**
+		 * @brief Construct a new soa vector iterator object.
+		 *
+		 * @param pContainer The container pointer.
+		 * @param index The element index.
+		 */
+		constexpr explicit soa_vector_iterator(Container *pContainer, const uint64_t index) : m_pContainer(pContainer), m_Index(index) {}
+
+		/**
+		 * @brief Get the current element index.
+		 *
+		 * @return constexpr uint64_t The index.
+		 */
+		constexpr INV_NODISCARD uint64_t index() const { return m_Index; }
+
+		/**
+		 * @brief Dereference operator.
+		 *
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference operator*() const { return (*m_pContainer)[m_Index]; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param offset The offset to access.
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const difference_type offset) const { return (*m_pContainer)[m_Index + offset]; }
+
+		/**
+		 * @brief Pre-increment operator.
+		 *
+		 * @return constexpr soa_vector_iterator& This iterator.
+		 */
+		constexpr soa_vector_iterator &operator++()
+		{
+			++m_Index;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-increment operator.
+		 *
+		 * @return constexpr soa_vector_iterator The previous iterator.
+		 */
+		constexpr soa_vector_iterator operator++(int)
+		{
+			auto thisCopy = *this;
+			++m_Index;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Pre-decrement operator.
+		 *
+		 * @return constexpr soa_vector_iterator& This iterator.
+		 */
+		constexpr soa_vector_iterator &operator--()
+		{
+			--m_Index;
+			return *this;
+		}
+
+		/**
+		 * @brief Post-decrement operator.
+		 *
+		 * @return constexpr soa_vector_iterator The previous iterator.
+		 */
+		constexpr soa_vector_iterator operator--(int)
+		{
+			auto thisCopy = *this;
+			--m_Index;
+			return thisCopy;
+		}
+
+		/**
+		 * @brief Increment-Assign operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr soa_vector_iterator& This iterator.
+		 */
+		constexpr soa_vector_iterator &operator+=(const difference_type offset)
+		{
+			m_Index += offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Decrement-Assign operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr soa_vector_iterator& This iterator.
+		 */
+		constexpr soa_vector_iterator &operator-=(const difference_type offset)
+		{
+			m_Index -= offset;
+			return *this;
+		}
+
+		/**
+		 * @brief Addition operator.
+		 *
+		 * @param offset The number to add.
+		 * @return constexpr soa_vector_iterator The new iterator.
+		 */
+		constexpr INV_NODISCARD soa_vector_iterator operator+(const difference_type offset) const { return soa_vector_iterator(m_pContainer, m_Index + offset); }
+
+		/**
+		 * @brief Subtraction operator.
+		 *
+		 * @param offset The number to subtract.
+		 * @return constexpr soa_vector_iterator The new iterator.
+		 */
+		constexpr INV_NODISCARD soa_vector_iterator operator-(const difference_type offset) const { return soa_vector_iterator(m_pContainer, m_Index - offset); }
+
+		/**
+		 * @brief Get the difference between this and another iterator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr difference_type The difference.
+		 */
+		constexpr INV_NODISCARD difference_type operator-(const soa_vector_iterator &other) const { return static_cast<difference_type>(m_Index) - static_cast<difference_type>(other.m_Index); }
+
+		/**
+		 * @brief Is equal to operator.
+		 *
+		 * @param other The other iterator.
+		 * @return true if both the iterators point to the same element.
+		 * @return false if the iterators point to different elements.
+		 */
+		constexpr INV_NODISCARD bool operator==(const soa_vector_iterator &other) const { return m_Index == other.m_Index; }
+
+		/**
+		 * @brief Three-way comparison operator.
+		 *
+		 * @param other The other iterator.
+		 * @return constexpr auto The ordering.
+		 */
+		constexpr INV_NODISCARD auto operator<=>(const soa_vector_iterator &other) const { return m_Index <=> other.m_Index; }
+	};
+
+	/**
+	 * @brief Structure of arrays vector.
+	 * This container splits an aggregate type into its members and stores each member in its own contiguous column. A pass which only touches one member only reads that column,
+	 * and the columns can be accessed directly as spans which makes field-wise kernels easy to vectorize. Elements are accessed using soa_reference proxies.
+	 *
+	 * @tparam Type The aggregate type. This must be default constructible.
+	 * @tparam Allocator The allocator type. This is rebound for each column.
+	 * @tparam Members The member pointers of the aggregate type to store. Members which are not listed are not stored.
+	 */
+	template <class Type, class Allocator, auto... Members>
+	class soa_vector final
+	{
+		static_assert(sizeof...(Members) > 0, "At least one member is required to store the type as a structure of arrays!");
+
+		template <auto Member>
+		using column_type = std::vector<member_type<Member>, typename std::allocator_traits<Allocator>::template rebind_alloc<member_type<Member>>>;
+
+		std::tuple<column_type<Members>...> m_Columns;
+
+	public:
+		using value_type = Type;
+		using allocator_type = Allocator;
+		using reference = soa_reference<Type, false, Members...>;
+		using const_reference = soa_reference<Type, true, Members...>;
+		using iterator = soa_vector_iterator<soa_vector>;
+		using const_iterator = soa_vector_iterator<const soa_vector>;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr soa_vector() = default;
+
+		/**
+		 * @brief Construct a new soa vector object.
+		 *
+		 * @param allocator The allocator used by the columns.
+		 */
+		constexpr explicit soa_vector(const Allocator &allocator) : m_Columns(column_type<Members>(allocator)...) {}
+
+		/**
+		 * @brief Emplace a new element at the back of the container.
+		 * The element is constructed using the arguments and its members are moved to the columns.
+		 *
+		 * @tparam Types The constructor argument types.
+		 * @param arguments The constructor arguments.
+		 * @return constexpr reference The emplaced element reference.
+		 */
+		template <class... Types>
+		constexpr reference emplace_back(Types &&...arguments)
+		{
+			Type value(std::forward<Types>(arguments)...);
+			((std::get<get_member_index<Members, Members...>()>(m_Columns).emplace_back(std::move(value.*Members))), ...);
+
+			return back();
+		}
+
+		/**
+		 * @brief Remove the last element.
+		 */
+		constexpr void pop_back()
+		{
+			std::apply([](auto &...columns)
+					   { (columns.pop_back(), ...); },
+					   m_Columns);
+		}
+
+		/**
+		 * @brief Erase a single element from the container.
+		 * All the elements after it will be moved down by one.
+		 *
+		 * @param position The position to erase.
+		 * @return constexpr iterator The iterator to the element after the erased one.
+		 */
+		constexpr iterator erase(const iterator position)
+		{
+			const auto index = position.index();
+			std::apply([index](auto &...columns)
+					   { (columns.erase(columns.begin() + index), ...); },
+					   m_Columns);
+
+			return iterator(this, index);
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of elements without reallocating.
+		 *
+		 * @param count The element count.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			std::apply([count](auto &...columns)
+					   { (columns.reserve(count), ...); },
+					   m_Columns);
+		}
+
+		/**
+		 * @brief Release the unused memory of all the columns.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			std::apply([](auto &...columns)
+					   { (columns.shrink_to_fit(), ...); },
+					   m_Columns);
+		}
+
+		/**
+		 * @brief Clear all the columns.
+		 */
+		constexpr void clear()
+		{
+			std::apply([](auto &...columns)
+					   { (columns.clear(), ...); },
+					   m_Columns);
+		}
+
+		/**
+		 * @brief Get the allocator used by the container.
+		 *
+		 * @return constexpr allocator_type The allocator.
+		 */
+		constexpr INV_NODISCARD allocator_type get_allocator() const { return allocator_type(std::get<0>(m_Columns).get_allocator()); }
+
+		/**
+		 * @brief Get the number of elements stored.
+		 *
+		 * @return constexpr uint64_t The size.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return std::get<0>(m_Columns).size(); }
+
+		/**
+		 * @brief Check if the container is empty.
+		 *
+		 * @return true if the container is empty.
+		 * @return false if the container is not empty.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return std::get<0>(m_Columns).empty(); }
+
+		/**
+		 * @brief Get the number of elements that can be stored without reallocating.
+		 * This is the capacity of the smallest column.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept
+		{
+			return std::apply([](const auto &...columns)
+							  { return std::min({static_cast<uint64_t>(columns.capacity())...}); },
+							  m_Columns);
+		}
+
+		/**
+		 * @brief Get a single column of the container.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() { return std::span(std::get<get_member_index<Member, Members...>()>(m_Columns)); }
+
+		/**
+		 * @brief Get a single column of the container.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() const { return std::span(std::get<get_member_index<Member, Members...>()>(m_Columns)); }
+
+		/**
+		 * @brief Get the last element.
+		 *
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference back() { return (*this)[size() - 1]; }
+
+		/**
+		 * @brief Get the last element.
+		 *
+		 * @return constexpr const_reference The element reference.
+		 */
+		constexpr INV_NODISCARD const_reference back() const { return (*this)[size() - 1]; }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param index The index to access.
+		 * @return constexpr reference The element reference.
+		 */
+		constexpr INV_NODISCARD reference operator[](const uint64_t index) { return reference(std::get<get_member_index<Members, Members...>()>(m_Columns)[index]...); }
+
+		/**
+		 * @brief Subscript operator.
+		 *
+		 * @param index The index to access.
+		 * @return constexpr const_reference The element reference.
+		 */
+		constexpr INV_NODISCARD const_reference operator[](const uint64_t index) const { return const_reference(std::get<get_member_index<Members, Members...>()>(m_Columns)[index]...); }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr iterator The iterator.
+		 */
+		constexpr INV_NODISCARD iterator begin() noexcept { return iterator(this, 0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr iterator The iterator.
+		 */
+		constexpr INV_NODISCARD iterator end() noexcept { return iterator(this, size()); }
+
+		/**
+		 * @brief Get the begin iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+		/**
+		 * @brief Get the end iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+		/**
+		 * @brief Get the const begin iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator cbegin() const noexcept { return begin(); }
+
+		/**
+		 * @brief Get the const end iterator.
+		 *
+		 * @return constexpr const_iterator The iterator.
+		 */
+		constexpr INV_NODISCARD const_iterator cend() const noexcept { return end(); }
+	};
+} // namespace inventory
@@ -2,39 +2,40 @@
 
 #pragma once
 
-#include "defaults.hpp"
-#include "platform.hpp"
+#include "paged_index_array.hpp"
+#include "storage_policy.hpp"
 
 #include <vector>
 #include <algorithm>
 
-#ifdef INV_USE_UNSEQ
-#	include <execution>
-
-#endif
-
 namespace inventory
 {
 	/**
 	 * @brief Sparse array object.
-	 * This object consists of three main arrays. dense_vector, which contains the actual data. sparse_vector(s) which contains the actual indexes of the data in the dense_vector, and another
-	 * vector containing the reusable indexes. Here we use another vector for this because it's easier to index it rather than iterating over the sparse index array and finding out which
-	 * index is usable.
+	 * This object consists of four main arrays. dense_vector, which contains the actual data. sparse_pages which contains the actual indexes of the data in the dense_vector, another
+	 * vector containing the reusable indexes, and a back-reference vector which is parallel to the dense_vector and contains the sparse index of each of the dense entries. Here we use
+	 * another vector for the reusable indexes because it's easier to index it rather than iterating over the sparse index array and finding out which index is usable.
+	 *
+	 * The sparse indexes are stored in pages which are allocated on demand, so the memory used by them scales with the number of live entries rather than the highest index.
 	 *
 	 * @tparam Type The type of data to store.
 	 * @tparam Index The integral type used to index. Default is uint64_t.
+	 * @tparam PageSize The number of sparse indexes stored in a single page. Default is default_page_size.
+	 * @tparam Storage The storage policy of the dense array. Default is contiguous_storage.
+	 * @tparam Allocator The allocator type. This is rebound for the index containers. Default is std::allocator<Type>.
 	 */
-	template <class Type, index_type Index = uint64_t>
+	template <class Type, index_type Index = uint64_t, uint64_t PageSize = default_page_size, class Storage = contiguous_storage, class Allocator = std::allocator<Type>>
 	class sparse_array final
 	{
-		using dense_vector = std::vector<Type>;
-		using sparse_vector = std::vector<Index>;
-		using availability_vector = std::vector<bool>;
-		static constexpr Index invalid_index = -1;
+		using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Index>;
+		using dense_vector = typename Storage::template container<Type, Allocator>;
+		using sparse_pages = paged_index_array<Index, PageSize, index_allocator>;
+		using sparse_vector = std::vector<Index, index_allocator>;
 
 		dense_vector m_DenseArray = {};		  // This is where we store the actual data.
-		sparse_vector m_SparseArray = {};	  // This is where we store the indexes.
+		sparse_pages m_SparseArray = {};	  // This is where we store the indexes.
 		sparse_vector m_ReusableIndexes = {}; // This is where we store the reusable indexes.
+		sparse_vector m_BackReferences = {};  // This is where we store the sparse index of each dense entry.
 
 		/**
 		 * @brief Reducer function used to reduce the index by one.
@@ -47,6 +48,9 @@ namespace inventory
 	public:
 		using value_type = Type;
 		using index_type = Index;
+		using allocator_type = Allocator;
+		using reference = typename dense_vector::reference;
+		using const_reference = typename dense_vector::const_reference;
 		using iterator = typename dense_vector::iterator;
 		using const_iterator = typename dense_vector::const_iterator;
 
@@ -55,69 +59,131 @@ namespace inventory
 		 */
 		constexpr sparse_array() = default;
 
+		/**
+		 * @brief Construct a new sparse array object.
+		 *
+		 * @param allocator The allocator used by all the internal containers.
+		 */
+		constexpr explicit sparse_array(const Allocator &allocator)
+			: m_DenseArray(allocator), m_SparseArray(index_allocator(allocator)), m_ReusableIndexes(index_allocator(allocator)), m_BackReferences(index_allocator(allocator)) {}
+
+		/**
+		 * @brief Default copy constructor.
+		 *
+		 * @param other The other array.
+		 */
+		sparse_array(const sparse_array &other) = default;
+
+		/**
+		 * @brief Default move constructor.
+		 *
+		 * @param other The other array.
+		 */
+		sparse_array(sparse_array &&other) noexcept = default;
+
 		/**
 		 * @brief Default destructor.
 		 */
 		constexpr ~sparse_array() = default;
 
+		/**
+		 * @brief Default copy assignment operator.
+		 *
+		 * @param other The other array.
+		 * @return sparse_array& This object reference.
+		 */
+		sparse_array &operator=(const sparse_array &other) = default;
+
+		/**
+		 * @brief Default move assignment operator.
+		 *
+		 * @param other The other array.
+		 * @return sparse_array& This object reference.
+		 */
+		sparse_array &operator=(sparse_array &&other) noexcept = default;
+
 		/**
 		 * @brief Emplace a new element to the dense array.
 		 *
 		 * @tparam Types The variadic argument types.
 		 * @param data The data to emplace.
-		 * @return constexpr std::pair<Index, std::reference_wrapper<Type>> The index position of the emplaced data and the emplaced data reference.
+		 * @return constexpr std::pair<Index, reference> The index position of the emplaced data and the emplaced data reference.
 		 */
 		template <class... Types>
-		constexpr INV_NODISCARD std::pair<Index, Type *> emplace(Types &&...data)
+		constexpr INV_NODISCARD std::pair<Index, reference> emplace(Types &&...data)
 		{
 			auto index = get_index();
-			auto &emplaced = m_DenseArray.emplace_back(std::forward<Types>(data)...);
-			update_sparse_vector(index, m_DenseArray.size() - 1);
+			decltype(auto) emplaced = m_DenseArray.emplace_back(std::forward<Types>(data)...);
+			m_BackReferences.emplace_back(index);
+			update_sparse_vector(index, static_cast<Index>(m_DenseArray.size() - 1));
 
-			return std::make_pair(index, &emplaced);
+			return std::pair<Index, reference>(index, emplaced);
 		}
 
 		/**
 		 * @brief Remove a single entry from the dense array using it's index.
-		 * Note that this operation is quite slow, and should not be done in places such as clearing this array.
+		 * This will move the last element of the dense array to the removed position, and update it's sparse index using the back-reference. This operation takes O(1) time,
+		 * but does not preserve the order of the dense array. Use stable_remove() if the order needs to be preserved.
 		 *
 		 * @param index The index to remove.
 		 */
 		constexpr void remove(Index index)
 		{
-			// Remove the data from the dense array.
 			const auto indexToErase = m_SparseArray[index];
-			m_DenseArray.erase(m_DenseArray.begin() + indexToErase);
+			const auto lastIndex = static_cast<Index>(m_DenseArray.size() - 1);
 
-			// If the dense array is empty, we can clear the other two vectors.
-			if (m_DenseArray.empty())
+			// Move the last element to the hole, and point its sparse index to the new location.
+			if (indexToErase != lastIndex)
 			{
-				m_SparseArray.clear();
-				m_ReusableIndexes.clear();
+				m_DenseArray[indexToErase] = std::move(m_DenseArray.back());
+				m_BackReferences[indexToErase] = m_BackReferences.back();
+				m_SparseArray[m_BackReferences[indexToErase]] = indexToErase;
 			}
 
-			// If the index is in the last position of the sparse array, we can clear it along with the rest of the invalid indexes.
-			else if (index == m_SparseArray.size() - 1)
-			{
-				m_SparseArray.pop_back();
-				shrink_to_fit();
-			}
+			m_DenseArray.pop_back();
+			m_BackReferences.pop_back();
+			release_index(index);
+		}
 
-			// Else we can add the index as a reusable index, and subtract one from the sparse index from that point on.
-			else
-			{
-				m_ReusableIndexes.emplace_back(index);
+		/**
+		 * @brief Remove a single entry from the dense array using it's index while preserving the order of the dense array.
+		 * Note that this operation is quite slow (O(n)), and should not be done in places such as clearing this array.
+		 *
+		 * @param index The index to remove.
+		 */
+		constexpr void stable_remove(Index index)
+		{
+			// Remove the data from the dense array.
+			const auto indexToErase = m_SparseArray[index];
+			m_DenseArray.erase(m_DenseArray.begin() + indexToErase);
+			m_BackReferences.erase(m_BackReferences.begin() + indexToErase);
 
-				auto beginItr = m_SparseArray.begin() + index;
+			// Every entry after the erased one moved down by one, so we need to reduce their sparse indexes by one.
+			for (auto itr = m_BackReferences.begin() + indexToErase; itr != m_BackReferences.end(); ++itr)
+				m_SparseArray[*itr] = reducer(m_SparseArray[*itr]);
 
-#ifdef INV_USE_UNSEQ
-				std::transform(std::execution::unseq, beginItr, m_SparseArray.end(), beginItr, reducer);
+			release_index(index);
+		}
 
-#else
-				std::transform(beginItr, m_SparseArray.end(), beginItr, reducer);
+		/**
+		 * @brief Swap the elements at two positions of the dense array.
+		 * The sparse indexes of both the elements are updated using the back-references, so the elements can still be accessed using the same indexes.
+		 *
+		 * @param first The first dense array position.
+		 * @param second The second dense array position.
+		 */
+		constexpr void swap_positions(const uint64_t first, const uint64_t second)
+		{
+			if (first == second)
+				return;
 
-#endif
-			}
+			Type temporary = std::move(m_DenseArray[first]);
+			m_DenseArray[first] = std::move(m_DenseArray[second]);
+			m_DenseArray[second] = std::move(temporary);
+
+			std::swap(m_BackReferences[first], m_BackReferences[second]);
+			m_SparseArray[m_BackReferences[first]] = static_cast<Index>(first);
+			m_SparseArray[m_BackReferences[second]] = static_cast<Index>(second);
 		}
 
 		/**
@@ -128,23 +194,118 @@ namespace inventory
 			m_DenseArray.clear();
 			m_SparseArray.clear();
 			m_ReusableIndexes.clear();
+			m_BackReferences.clear();
+		}
+
+		/**
+		 * @brief Get the allocator used by the container.
+		 *
+		 * @return constexpr allocator_type The allocator.
+		 */
+		constexpr INV_NODISCARD allocator_type get_allocator() const { return allocator_type(m_SparseArray.get_allocator()); }
+
+		/**
+		 * @brief Reserve enough space to store a given number of elements without reallocating.
+		 *
+		 * @param count The number of elements.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			m_DenseArray.reserve(count);
+			m_BackReferences.reserve(count);
 		}
 
+		/**
+		 * @brief Get the number of elements that can be stored without reallocating.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept { return m_DenseArray.capacity(); }
+
+		/**
+		 * @brief Shrink the container to fit the optimal size.
+		 * This will release the slack in the dense array and the back-references, drop the trailing unused sparse indexes (along with their reusable entries) and release the
+		 * slack in the reusable index vector.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			m_DenseArray.shrink_to_fit();
+			m_BackReferences.shrink_to_fit();
+			m_SparseArray.shrink_to_fit();
+
+			const auto sparseSize = m_SparseArray.size();
+			std::erase_if(m_ReusableIndexes, [sparseSize](const Index index)
+						  { return index >= sparseSize; });
+
+			m_ReusableIndexes.shrink_to_fit();
+		}
+
+		/**
+		 * @brief Get a single column of the dense array.
+		 * This is only available when the dense array uses the structure of arrays storage.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() { return m_DenseArray.template column<Member>(); }
+
+		/**
+		 * @brief Get a single column of the dense array.
+		 * This is only available when the dense array uses the structure of arrays storage.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() const { return m_DenseArray.template column<Member>(); }
+
+		/**
+		 * @brief Get the number of elements stored in the container.
+		 *
+		 * @return constexpr uint64_t The element count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_DenseArray.size(); }
+
+		/**
+		 * @brief Check if the container is empty.
+		 *
+		 * @return true if there are no elements in the container.
+		 * @return false if there are elements in the container.
+		 */
+		constexpr INV_NODISCARD bool empty() const noexcept { return m_DenseArray.empty(); }
+
+		/**
+		 * @brief Get the sparse index of an element using its position in the dense array.
+		 *
+		 * @param position The dense array position.
+		 * @return constexpr Index The sparse index.
+		 */
+		constexpr INV_NODISCARD Index index_of(const uint64_t position) const { return m_BackReferences[position]; }
+
+		/**
+		 * @brief Get the dense array position of an element using its sparse index.
+		 *
+		 * @param index The sparse index.
+		 * @return constexpr Index The dense array position.
+		 */
+		constexpr INV_NODISCARD Index position_of(const Index &index) const { return m_SparseArray[index]; }
+
 		/**
 		 * @brief Get an element at a given position.
 		 *
 		 * @param index The index to access.
-		 * @return constexpr Type& The data reference.
+		 * @return constexpr reference The data reference.
 		 */
-		constexpr INV_NODISCARD Type &at(const Index &index) { return m_DenseArray[m_SparseArray[index]]; }
+		constexpr INV_NODISCARD reference at(const Index &index) { return m_DenseArray[m_SparseArray[index]]; }
 
 		/**
 		 * @brief Get an element at a given position.
 		 *
 		 * @param index The index to access.
-		 * @return constexpr const Type& The data reference.
+		 * @return constexpr const_reference The data reference.
 		 */
-		constexpr INV_NODISCARD const Type &at(const Index &index) const { return m_DenseArray[m_SparseArray[index]]; }
+		constexpr INV_NODISCARD const_reference at(const Index &index) const { return m_DenseArray[m_SparseArray[index]]; }
 
 		/**
 		 * @brief Get the begin iterator.
@@ -181,29 +342,23 @@ namespace inventory
 		 * @return constexpr true if the index is present in the container.
 		 * @return constexpr false if the index is not present in the container.
 		 */
-		constexpr INV_NODISCARD bool contains(const Index &index) const
-		{
-			if (index < m_SparseArray.size())
-				return m_SparseArray[index] > invalid_index;
-
-			return false;
-		}
+		constexpr INV_NODISCARD bool contains(const Index &index) const { return m_SparseArray.contains(index); }
 
 		/**
 		 * @brief Subscript operator.
 		 *
 		 * @param index The index to access.
-		 * @return constexpr Type& The data reference.
+		 * @return constexpr reference The data reference.
 		 */
-		constexpr INV_NODISCARD Type &operator[](const Index &index) { return m_DenseArray[m_SparseArray[index]]; }
+		constexpr INV_NODISCARD reference operator[](const Index &index) { return m_DenseArray[m_SparseArray[index]]; }
 
 		/**
 		 * @brief Subscript operator.
 		 *
 		 * @param index The index to access.
-		 * @return constexpr const Type& The data reference.
+		 * @return constexpr const_reference The data reference.
 		 */
-		constexpr INV_NODISCARD const Type &operator[](const Index &index) const { return m_DenseArray[m_SparseArray[index]]; }
+		constexpr INV_NODISCARD const_reference operator[](const Index &index) const { return m_DenseArray[m_SparseArray[index]]; }
 
 	private:
 		/**
@@ -221,37 +376,37 @@ namespace inventory
 				return index;
 			}
 			else
-				return static_cast<Index>(m_DenseArray.size());
+				return static_cast<Index>(m_SparseArray.size());
 		}
 
 		/**
-		 * @brief update the sparse vector.
+		 * @brief Release an index after its data has been removed from the dense array.
 		 *
-		 * @param givenIndex The index given to store the data.
-		 * @param storedIndex The actual index of the stored data.
+		 * @param index The index to release.
 		 */
-		constexpr void update_sparse_vector(const Index givenIndex, const Index storedIndex)
+		constexpr void release_index(const Index index)
 		{
-			if (givenIndex < m_SparseArray.size())
-				m_SparseArray[givenIndex] = storedIndex;
+			// If the dense array is empty, we can clear the other vectors.
+			if (m_DenseArray.empty())
+			{
+				m_SparseArray.clear();
+				m_ReusableIndexes.clear();
+			}
 
+			// Else we can invalidate the index and add it as a reusable index.
 			else
-				m_SparseArray.emplace_back(storedIndex);
+			{
+				m_SparseArray.reset(index);
+				m_ReusableIndexes.emplace_back(index);
+			}
 		}
 
 		/**
-		 * @brief Shrink the sparse array to fit the optimal size.
+		 * @brief update the sparse vector.
+		 *
+		 * @param givenIndex The index given to store the data.
+		 * @param storedIndex The actual index of the stored data.
 		 */
-		constexpr void shrink_to_fit()
-		{
-			for (auto itr = m_SparseArray.end() - 1; itr != m_SparseArray.begin(); --itr)
-			{
-				if (*itr > invalid_index)
-				{
-					m_SparseArray.erase(itr, m_SparseArray.end());
-					break;
-				}
-			}
-		}
+		constexpr void update_sparse_vector(const Index givenIndex, const Index storedIndex) { m_SparseArray.assign(givenIndex, storedIndex); }
 	};
 } // namespace inventory
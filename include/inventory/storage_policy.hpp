@@ -0,0 +1,96 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include "chunked_vector.hpp"
+#include "soa_vector.hpp"
+
+namespace inventory
+{
+	/**
+	 * @brief Contiguous storage policy.
+	 * Components are stored in a single std::vector. This gives the best iteration performance, but growing the storage relocates all the components and invalidates all the
+	 * references to them.
+	 */
+	struct contiguous_storage final
+	{
+		template <class Type, class Allocator = std::allocator<Type>>
+		using container = std::vector<Type, Allocator>;
+	};
+
+	/**
+	 * @brief Aligned contiguous storage policy.
+	 * Components are stored in a single std::vector like the contiguous storage, but the array always starts on an alignment boundary and its capacity is padded to a whole
+	 * number of alignment blocks. Combined with the cache aligned chunk sizes used by system::chunks() and the parallel for_each(), every chunk of components starts on an
+	 * alignment boundary as well, so vectorized kernels can use aligned loads and no chunk splits a cache line with another. Use default_vector_alignment to align for the
+	 * vector registers instead of the cache lines.
+	 *
+	 * @tparam Alignment The alignment of the component array in bytes. This must be a power of two. Default is default_cache_line_size.
+	 */
+	template <uint64_t Alignment = default_cache_line_size>
+	struct aligned_storage final
+	{
+		template <class Type, class Allocator = std::allocator<Type>>
+		using container = std::vector<Type, aligned_allocator<Type, Alignment, Allocator>>;
+	};
+
+	/**
+	 * @brief Chunked storage policy.
+	 * Components are stored in fixed-size chunks which are never relocated. Growing the storage does not invalidate references to the existing components, and there are no
+	 * large reallocation copies. Note that removing a component still moves the last component into the freed slot.
+	 *
+	 * @tparam ChunkSize The number of components stored in a single chunk. This must be a power of two. Default is 1024.
+	 */
+	template <uint64_t ChunkSize = 1024>
+	struct chunked_storage final
+	{
+		template <class Type, class Allocator = std::allocator<Type>>
+		using container = chunked_vector<Type, ChunkSize, Allocator>;
+	};
+
+	/**
+	 * @brief Structure of arrays storage policy.
+	 * Each of the listed members of an aggregate component is stored in its own contiguous column. Components are accessed using soa_reference proxies, and the columns can be
+	 * accessed as spans using system::column<>(). This is useful when a pass only touches a few members of a large component.
+	 *
+	 * For example:
+	 * @code{cpp}
+	 * template <>
+	 * struct inventory::storage_traits<camera_component>
+	 * {
+	 *     using policy = inventory::soa_storage<&camera_component::m_View, &camera_component::m_Proj>;
+	 * };
+	 * @endcode
+	 *
+	 * @tparam Members The member pointers of the component to store.
+	 */
+	template <auto... Members>
+	struct soa_storage final
+	{
+		template <class Type, class Allocator = std::allocator<Type>>
+		using container = soa_vector<Type, Allocator, Members...>;
+	};
+
+	/**
+	 * @brief Storage traits struct.
+	 * This is used to select the storage policy of a single component type. By default all the components use the contiguous storage, and the user can specialize this to
+	 * change it.
+	 *
+	 * For example:
+	 * @code{cpp}
+	 * template <>
+	 * struct inventory::storage_traits<transform_component>
+	 * {
+	 *     using policy = inventory::chunked_storage<1024>;
+	 * };
+	 * @endcode
+	 *
+	 * @tparam Component The component type.
+	 */
+	template <class Component>
+	struct storage_traits
+	{
+		using policy = contiguous_storage;
+	};
+} // namespace inventory
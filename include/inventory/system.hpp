@@ -4,31 +4,65 @@
 
 #include "entity.hpp"
 #include "sparse_array.hpp"
+#include "each_iterator.hpp"
+#include "parallel.hpp"
+
+#include <limits>
+#include <ranges>
+#include <span>
 
 namespace inventory
 {
 	/**
 	 * @brief System class.
-	 * This class is used to store a single component type.
+	 * This class is used to store a single component type. Alongside the components, the system keeps a packed array of the owning entity indexes which is parallel to
+	 * the dense component array, so that the owner of each component can be found without scanning the entities.
+	 *
+	 * If change tracking is enabled for the component (using change_tracking_traits), the system also keeps the tick in which each component was added and last
+	 * changed in two more arrays which are parallel to the dense component array.
 	 *
 	 * @tparam Component The component type.
 	 * @tparam ComponentIndex The component index type. Default is the default_index_type.
+	 * @tparam EntityIndex The entity index type. Default is the default_index_type.
+	 * @tparam Storage The storage policy used to store the components. Default is the policy set by the storage_traits of the component.
+	 * @tparam Allocator The allocator type. Default is std::allocator<Component>.
 	 */
-	template <class Component, index_type ComponentIndex = default_index_type>
+	template <class Component, index_type ComponentIndex = default_index_type, index_type EntityIndex = default_index_type, class Storage = typename storage_traits<Component>::policy, class Allocator = std::allocator<Component>>
 	class system final
 	{
-		using container = sparse_array<Component, ComponentIndex>;
+		using container = sparse_array<Component, ComponentIndex, default_page_size, Storage, Allocator>;
+		using owner_container = std::vector<EntityIndex, typename std::allocator_traits<Allocator>::template rebind_alloc<EntityIndex>>;
+		using tick_container = std::vector<uint64_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>>;
+
 		container m_Container;
+		owner_container m_Owners;
+		tick_container m_AddedTicks;
+		tick_container m_ChangedTicks;
 
 	public:
+		using value_type = Component;
+		using allocator_type = Allocator;
+		using reference = typename container::reference;
+		using const_reference = typename container::const_reference;
 		using iterator = typename container::iterator;
 		using const_iterator = typename container::const_iterator;
+		using each_iterator_type = each_iterator<typename owner_container::const_iterator, iterator>;
+		using const_each_iterator_type = each_iterator<typename owner_container::const_iterator, const_iterator>;
+
+		static constexpr bool is_tracked = tracked_component<Component>;
 
 		/**
 		 * @brief Default constructor.
 		 */
 		constexpr system() = default;
 
+		/**
+		 * @brief Construct a new system object.
+		 *
+		 * @param allocator The allocator used to store the components.
+		 */
+		constexpr explicit system(const Allocator &allocator) : m_Container(allocator), m_Owners(allocator), m_AddedTicks(allocator), m_ChangedTicks(allocator) {}
+
 		/**
 		 * @brief Register a new entity to the system.
 		 *
@@ -37,17 +71,93 @@ namespace inventory
 		 * @param ent The entity.
 		 * @param index The entity index.
 		 * @param arguments The component constructor arguments.
-		 * @return constexpr Component& The component reference.
+		 * @return constexpr reference The component reference.
 		 */
 		template <class Entity, class... Types>
-		constexpr INV_NODISCARD Component &register_entity(Entity &ent, Types &&...arguments)
+		constexpr INV_NODISCARD reference register_entity(Entity &ent, const EntityIndex index, Types &&...arguments)
 		{
+			m_Owners.emplace_back(index);
+
+			if constexpr (is_tracked)
+			{
+				m_AddedTicks.emplace_back(0);
+				m_ChangedTicks.emplace_back(0);
+			}
+
 			auto result = m_Container.emplace(std::forward<Types>(arguments)...);
 			ent.template register_component<Component>(result.first);
 
-			return *result.second;
+			return result.second;
 		}
 
+		/**
+		 * @brief Reserve enough space to store a given number of components without reallocating.
+		 *
+		 * @param count The number of components.
+		 */
+		constexpr void reserve(const uint64_t count)
+		{
+			m_Container.reserve(count);
+			m_Owners.reserve(count);
+
+			if constexpr (is_tracked)
+			{
+				m_AddedTicks.reserve(count);
+				m_ChangedTicks.reserve(count);
+			}
+		}
+
+		/**
+		 * @brief Get the number of components that can be stored without reallocating.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept { return m_Container.capacity(); }
+
+		/**
+		 * @brief Release the unused memory of the system.
+		 */
+		constexpr void shrink_to_fit()
+		{
+			m_Container.shrink_to_fit();
+			m_Owners.shrink_to_fit();
+
+			if constexpr (is_tracked)
+			{
+				m_AddedTicks.shrink_to_fit();
+				m_ChangedTicks.shrink_to_fit();
+			}
+		}
+
+		/**
+		 * @brief Get a single member column of the system.
+		 * This is only available for components which use the soa_storage policy. The returned span contains the member of every component in the iteration order of the
+		 * system, which makes it suitable for field-wise kernels.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() { return m_Container.template column<Member>(); }
+
+		/**
+		 * @brief Get a single member column of the system.
+		 * This is only available for components which use the soa_storage policy. The returned span contains the member of every component in the iteration order of the
+		 * system, which makes it suitable for field-wise kernels.
+		 *
+		 * @tparam Member The member pointer or the member position.
+		 * @return constexpr decltype(auto) The column span.
+		 */
+		template <auto Member>
+		constexpr INV_NODISCARD decltype(auto) column() const { return m_Container.template column<Member>(); }
+
+		/**
+		 * @brief Get the number of components stored in the system.
+		 *
+		 * @return constexpr uint64_t The component count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Container.size(); }
+
 		/**
 		 * @brief Unregister an entity from the system.
 		 *
@@ -57,29 +167,232 @@ namespace inventory
 		template <class Entity>
 		constexpr void unregister_entity(Entity &ent)
 		{
-			m_Container.remove(ent.template get_component_index<Component>());
+			const auto index = ent.template get_component_index<Component>();
+
+			// The container moves the last component to the hole, so we need to do the same with the owners (and the ticks).
+			const auto position = m_Container.position_of(index);
+			m_Owners[position] = m_Owners.back();
+			m_Owners.pop_back();
+
+			if constexpr (is_tracked)
+			{
+				m_AddedTicks[position] = m_AddedTicks.back();
+				m_AddedTicks.pop_back();
+
+				m_ChangedTicks[position] = m_ChangedTicks.back();
+				m_ChangedTicks.pop_back();
+			}
+
+			m_Container.remove(index);
 			ent.template register_component<Component>(invalid_index<ComponentIndex>);
 		}
 
+		/**
+		 * @brief Get the position of an entity's component in the iteration order.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return constexpr uint64_t The position.
+		 */
+		template <class Entity>
+		constexpr INV_NODISCARD uint64_t position_of(const Entity &ent) const { return m_Container.position_of(ent.template get_component_index<Component>()); }
+
+		/**
+		 * @brief Swap the components at two positions in the iteration order.
+		 * The owners (and the ticks) are swapped along with the components, and the entities can still access their components using the same component indexes.
+		 *
+		 * @param first The first position.
+		 * @param second The second position.
+		 */
+		constexpr void swap_positions(const uint64_t first, const uint64_t second)
+		{
+			m_Container.swap_positions(first, second);
+			std::swap(m_Owners[first], m_Owners[second]);
+
+			if constexpr (is_tracked)
+			{
+				std::swap(m_AddedTicks[first], m_AddedTicks[second]);
+				std::swap(m_ChangedTicks[first], m_ChangedTicks[second]);
+			}
+		}
+
+		/**
+		 * @brief Get the owning entity indexes of the components.
+		 * The entities are in the same order as the components, so the i-th entity owns the i-th component in the iteration order.
+		 *
+		 * @return constexpr std::span<const EntityIndex> The entity indexes.
+		 */
+		constexpr INV_NODISCARD std::span<const EntityIndex> entities() const noexcept { return m_Owners; }
+
+		/**
+		 * @brief Get the owning entity index of a component at a given position in the iteration order.
+		 *
+		 * @param position The position of the component.
+		 * @return constexpr EntityIndex The entity index.
+		 */
+		constexpr INV_NODISCARD EntityIndex owner_of(const uint64_t position) const { return m_Owners[position]; }
+
+		/**
+		 * @brief Get a range which yields the owning entity index along with the component.
+		 *
+		 * @return constexpr decltype(auto) The range of (entity, component) pairs.
+		 */
+		constexpr INV_NODISCARD decltype(auto) each() { return std::ranges::subrange(each_iterator_type(m_Owners.cbegin(), m_Container.begin()), each_iterator_type(m_Owners.cend(), m_Container.end())); }
+
+		/**
+		 * @brief Get a range which yields the owning entity index along with the component.
+		 *
+		 * @return constexpr decltype(auto) The range of (entity, component) pairs.
+		 */
+		constexpr INV_NODISCARD decltype(auto) each() const { return std::ranges::subrange(const_each_iterator_type(m_Owners.cbegin(), m_Container.begin()), const_each_iterator_type(m_Owners.cend(), m_Container.end())); }
+
+		/**
+		 * @brief Get a range which yields the components in contiguous batches.
+		 * The batch size is rounded up so that every batch starts on a cache line boundary relative to the first component, which makes the batches suitable for
+		 * vectorized loops. With the aligned_storage policy the batches are aligned in memory as well. The last batch may be smaller. This is only available when the
+		 * components are stored contiguously.
+		 *
+		 * @param chunkSize The number of components in a single batch. Default is default_parallel_chunk_size.
+		 * @return constexpr decltype(auto) The range of std::span<Component> batches.
+		 */
+		constexpr INV_NODISCARD decltype(auto) chunks(const uint64_t chunkSize = default_parallel_chunk_size)
+			requires std::contiguous_iterator<iterator>
+		{
+			return create_chunk_view(size(), get_aligned_chunk_size<Component>(chunkSize), [pComponents = std::to_address(m_Container.begin())](const uint64_t first, const uint64_t last)
+									 { return std::span<Component>(pComponents + first, last - first); });
+		}
+
+		/**
+		 * @brief Get a range which yields the components in contiguous batches.
+		 * The batch size is rounded up so that every batch starts on a cache line boundary relative to the first component, which makes the batches suitable for
+		 * vectorized loops. With the aligned_storage policy the batches are aligned in memory as well. The last batch may be smaller. This is only available when the
+		 * components are stored contiguously.
+		 *
+		 * @param chunkSize The number of components in a single batch. Default is default_parallel_chunk_size.
+		 * @return constexpr decltype(auto) The range of std::span<const Component> batches.
+		 */
+		constexpr INV_NODISCARD decltype(auto) chunks(const uint64_t chunkSize = default_parallel_chunk_size) const
+			requires std::contiguous_iterator<const_iterator>
+		{
+			return create_chunk_view(size(), get_aligned_chunk_size<Component>(chunkSize), [pComponents = std::to_address(m_Container.begin())](const uint64_t first, const uint64_t last)
+									 { return std::span<const Component>(pComponents + first, last - first); });
+		}
+
+		/**
+		 * @brief Call a function for every component using an execution policy.
+		 * The components are split into cache aligned chunks of a fixed size, and the chunks are processed using the policy. The function is called with the owning
+		 * entity index and the component, or only with the component if it does not accept the entity index. Components must not be registered or unregistered while
+		 * this is running.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call.
+		 * @param chunkSize The number of components processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size)
+		{
+			const auto first = m_Container.begin();
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), size(), get_aligned_chunk_size<Component>(chunkSize), [this, first, &function](const uint64_t begin, const uint64_t end)
+						   {
+							   for (auto i = begin; i < end; i++)
+								   invoke_with_entity(function, m_Owners[i], first[i]); });
+		}
+
+		/**
+		 * @brief Call a function for every component using an execution policy.
+		 * The components are split into cache aligned chunks of a fixed size, and the chunks are processed using the policy. The function is called with the owning
+		 * entity index and the component, or only with the component if it does not accept the entity index.
+		 *
+		 * @tparam ExecutionPolicy The execution policy type.
+		 * @tparam Function The function type.
+		 * @param policy The execution policy.
+		 * @param function The function to call.
+		 * @param chunkSize The number of components processed by a single task. Default is default_parallel_chunk_size.
+		 */
+		template <execution_policy ExecutionPolicy, class Function>
+		void for_each(ExecutionPolicy &&policy, Function &&function, const uint64_t chunkSize = default_parallel_chunk_size) const
+		{
+			const auto first = m_Container.begin();
+			for_each_chunk(std::forward<ExecutionPolicy>(policy), size(), get_aligned_chunk_size<Component>(chunkSize), [this, first, &function](const uint64_t begin, const uint64_t end)
+						   {
+							   for (auto i = begin; i < end; i++)
+								   invoke_with_entity(function, m_Owners[i], first[i]); });
+		}
+
+		/**
+		 * @brief Set the added and changed ticks of an entity's component.
+		 * This is only available if change tracking is enabled for the component.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @param tick The tick in which the component was added.
+		 */
+		template <class Entity>
+			requires is_tracked
+		constexpr void mark_added(const Entity &ent, const uint64_t tick)
+		{
+			const auto position = m_Container.position_of(ent.template get_component_index<Component>());
+			m_AddedTicks[position] = tick;
+			m_ChangedTicks[position] = tick;
+		}
+
+		/**
+		 * @brief Set the changed tick of an entity's component.
+		 * This is only available if change tracking is enabled for the component.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @param tick The tick in which the component was changed.
+		 */
+		template <class Entity>
+			requires is_tracked
+		constexpr void mark_changed(const Entity &ent, const uint64_t tick) { m_ChangedTicks[m_Container.position_of(ent.template get_component_index<Component>())] = tick; }
+
+		/**
+		 * @brief Get the tick in which an entity's component was added.
+		 * This is only available if change tracking is enabled for the component.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return constexpr uint64_t The tick.
+		 */
+		template <class Entity>
+			requires is_tracked
+		constexpr INV_NODISCARD uint64_t added_tick(const Entity &ent) const { return m_AddedTicks[m_Container.position_of(ent.template get_component_index<Component>())]; }
+
+		/**
+		 * @brief Get the tick in which an entity's component was last changed.
+		 * This is only available if change tracking is enabled for the component.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return constexpr uint64_t The tick.
+		 */
+		template <class Entity>
+			requires is_tracked
+		constexpr INV_NODISCARD uint64_t changed_tick(const Entity &ent) const { return m_ChangedTicks[m_Container.position_of(ent.template get_component_index<Component>())]; }
+
 		/**
 		 * @brief Get a component from the container using the entity it is attached to.
 		 *
 		 * @tparam Entity The entity to get the component from.
 		 * @param ent The entity to index.
-		 * @return constexpr Component& The component reference.
+		 * @return constexpr reference The component reference.
 		 */
 		template <class Entity>
-		constexpr INV_NODISCARD Component &get(const Entity &ent) { return m_Container.at(ent.template get_component_index<Component>()); }
+		constexpr INV_NODISCARD reference get(const Entity &ent) { return m_Container.at(ent.template get_component_index<Component>()); }
 
 		/**
 		 * @brief Get a component from the container using the entity it is attached to.
 		 *
 		 * @tparam Entity The entity to get the component from.
 		 * @param ent The entity to index.
-		 * @return constexpr Component& The component reference.
+		 * @return constexpr const_reference The component reference.
 		 */
 		template <class Entity>
-		constexpr INV_NODISCARD const Component &get(const Entity &ent) const { return m_Container.at(ent.template get_component_index<Component>()); }
+		constexpr INV_NODISCARD const_reference get(const Entity &ent) const { return m_Container.at(ent.template get_component_index<Component>()); }
 
 	public:
 		/**
@@ -124,4 +437,120 @@ namespace inventory
 		 */
 		constexpr INV_NODISCARD decltype(auto) cend() const noexcept { return m_Container.cend(); }
 	};
+
+	/**
+	 * @brief Tag system class.
+	 * Tag components (empty components) does not require any storage, so this system only keeps track of the bits in the entities. Registering and unregistering only
+	 * toggles the entity's bit and does not allocate.
+	 *
+	 * @tparam Component The tag component type.
+	 * @tparam ComponentIndex The component index type.
+	 * @tparam EntityIndex The entity index type.
+	 * @tparam Storage The storage policy. This is ignored as tags are not stored.
+	 * @tparam Allocator The allocator type. This is ignored as tags are not stored.
+	 */
+	template <tag_component Component, index_type ComponentIndex, index_type EntityIndex, class Storage, class Allocator>
+	class system<Component, ComponentIndex, EntityIndex, Storage, Allocator> final
+	{
+		uint64_t m_Count = 0;
+
+	public:
+		using value_type = Component;
+		using allocator_type = Allocator;
+		using reference = Component;
+		using const_reference = Component;
+
+		static constexpr bool is_tracked = false;
+
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr system() = default;
+
+		/**
+		 * @brief Construct a new system object.
+		 *
+		 * @param allocator The allocator. This is not used.
+		 */
+		constexpr explicit system(const Allocator &) {}
+
+		/**
+		 * @brief Register a new entity to the system.
+		 *
+		 * @tparam Entity The entity type.
+		 * @tparam Types The constructor argument types for the component.
+		 * @param ent The entity.
+		 * @param index The entity index.
+		 * @param arguments The component constructor arguments.
+		 * @return constexpr reference The component.
+		 */
+		template <class Entity, class... Types>
+		constexpr INV_NODISCARD reference register_entity(Entity &ent, [[maybe_unused]] const EntityIndex index, Types &&...arguments)
+		{
+			if (!ent.template is_registered_to<Component>())
+				m_Count++;
+
+			ent.template register_component<Component>(0);
+			return Component(std::forward<Types>(arguments)...);
+		}
+
+		/**
+		 * @brief Reserve enough space to store a given number of components without reallocating.
+		 * Tags are not stored, so this does nothing.
+		 *
+		 * @param count The number of components.
+		 */
+		constexpr void reserve(const uint64_t) {}
+
+		/**
+		 * @brief Get the number of components that can be stored without reallocating.
+		 * Tags are not stored, so the system never allocates.
+		 *
+		 * @return constexpr uint64_t The capacity.
+		 */
+		constexpr INV_NODISCARD uint64_t capacity() const noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+		/**
+		 * @brief Release the unused memory of the system.
+		 * Tags are not stored, so this does nothing.
+		 */
+		constexpr void shrink_to_fit() {}
+
+		/**
+		 * @brief Get the number of entities registered to the system.
+		 *
+		 * @return constexpr uint64_t The entity count.
+		 */
+		constexpr INV_NODISCARD uint64_t size() const noexcept { return m_Count; }
+
+		/**
+		 * @brief Unregister an entity from the system.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity to unregister.
+		 */
+		template <class Entity>
+		constexpr void unregister_entity(Entity &ent)
+		{
+			if (ent.template is_registered_to<Component>())
+				m_Count--;
+
+			ent.template register_component<Component>(invalid_index<ComponentIndex>);
+		}
+
+		/**
+		 * @brief Get the component from the entity.
+		 * Since tags does not contain any data, this returns a default constructed component.
+		 *
+		 * @tparam Entity The entity to get the component from.
+		 * @param ent The entity to index.
+		 * @return constexpr const_reference The component.
+		 */
+		template <class Entity>
+		constexpr INV_NODISCARD const_reference get(const Entity &ent) const
+		{
+			assert((ent.template is_registered_to<Component>() && "This entity is not registered to this component! Make sure that the entity is registered to the component system before calling this."));
+			return Component();
+		}
+	};
 } // namespace inventory
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include <type_traits>
+
+namespace inventory
+{
+	/**
+	 * @brief Read access.
+	 * This can be passed to a scheduler task to state that the task only reads the given components.
+	 *
+	 * @tparam Components The components which are read.
+	 */
+	template <class... Components>
+	struct reads final
+	{
+	};
+
+	/**
+	 * @brief Write access.
+	 * This can be passed to a scheduler task to state that the task reads and writes the given components.
+	 *
+	 * @tparam Components The components which are written.
+	 */
+	template <class... Components>
+	struct writes final
+	{
+	};
+
+	/**
+	 * @brief Is read access type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_read_access : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is read access type trait.
+	 *
+	 * @tparam Components The components which are read.
+	 */
+	template <class... Components>
+	struct is_read_access<reads<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Is write access type trait.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	struct is_write_access : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Is write access type trait.
+	 *
+	 * @tparam Components The components which are written.
+	 */
+	template <class... Components>
+	struct is_write_access<writes<Components...>> : std::true_type
+	{
+	};
+
+	/**
+	 * @brief Task access concept.
+	 * This is satisfied by the read and write accesses.
+	 *
+	 * @tparam Type The type to check.
+	 */
+	template <class Type>
+	concept task_access = is_read_access<Type>::value || is_write_access<Type>::value;
+} // namespace inventory
@@ -0,0 +1,205 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inventory
+{
+	/**
+	 * @brief Thread pool class.
+	 * This is a work-stealing thread pool. Every worker has its own task queue, and tasks which are submitted from a worker are pushed to that worker's queue so they
+	 * stay on the same thread. Workers take the newest task from their own queue, and steal the oldest task from the other workers when their queue is empty.
+	 */
+	class thread_pool final
+	{
+		using task_type = std::function<void()>;
+
+		/**
+		 * @brief Worker queue structure.
+		 */
+		struct worker_queue final
+		{
+			std::mutex m_Mutex;
+			std::deque<task_type> m_Tasks;
+		};
+
+		std::vector<std::unique_ptr<worker_queue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::atomic<uint64_t> m_PendingCount = 0;
+		std::atomic<uint64_t> m_NextQueue = 0;
+		bool m_ShouldStop = false;
+
+		static inline thread_local const thread_pool *t_pCurrentPool = nullptr;
+		static inline thread_local uint64_t t_CurrentWorker = 0;
+
+	public:
+		/**
+		 * @brief Construct a new thread pool object.
+		 *
+		 * @param threadCount The number of worker threads. Default is the number of hardware threads.
+		 */
+		explicit thread_pool(const uint64_t threadCount = std::thread::hardware_concurrency())
+		{
+			const auto workerCount = std::max<uint64_t>(threadCount, 1);
+
+			m_Queues.reserve(workerCount);
+			for (uint64_t i = 0; i < workerCount; i++)
+				m_Queues.emplace_back(std::make_unique<worker_queue>());
+
+			m_Workers.reserve(workerCount);
+			for (uint64_t i = 0; i < workerCount; i++)
+				m_Workers.emplace_back(&thread_pool::worker, this, i);
+		}
+
+		/**
+		 * @brief Destructor.
+		 * This will wait till all the submitted tasks are executed.
+		 */
+		~thread_pool()
+		{
+			{
+				std::lock_guard lock(m_Mutex);
+				m_ShouldStop = true;
+			}
+
+			m_Condition.notify_all();
+			for (auto &worker : m_Workers)
+				worker.join();
+		}
+
+		thread_pool(const thread_pool &) = delete;
+		thread_pool &operator=(const thread_pool &) = delete;
+
+		/**
+		 * @brief Submit a new task to the pool.
+		 * If this is called from one of the workers, the task is pushed to that worker's queue. Otherwise the queues are picked in a round robin fashion.
+		 *
+		 * @param task The task to execute.
+		 */
+		void submit(task_type task)
+		{
+			const auto index = t_pCurrentPool == this ? t_CurrentWorker : m_NextQueue++ % m_Queues.size();
+
+			// The pending count is updated before the task is pushed so that a worker can never take the task before it is counted, and it is updated while holding
+			// the lock so that a worker which is about to sleep will not miss it.
+			{
+				std::lock_guard lock(m_Mutex);
+				m_PendingCount++;
+			}
+
+			{
+				std::lock_guard lock(m_Queues[index]->m_Mutex);
+				m_Queues[index]->m_Tasks.emplace_back(std::move(task));
+			}
+
+			m_Condition.notify_one();
+		}
+
+		/**
+		 * @brief Get the number of worker threads.
+		 *
+		 * @return uint64_t The thread count.
+		 */
+		INV_NODISCARD uint64_t size() const noexcept { return m_Workers.size(); }
+
+		/**
+		 * @brief Check if the current thread is one of the workers of this pool.
+		 *
+		 * @return true if the current thread is a worker.
+		 * @return false if the current thread is not a worker.
+		 */
+		INV_NODISCARD bool is_worker_thread() const noexcept { return t_pCurrentPool == this; }
+
+	private:
+		/**
+		 * @brief Worker thread function.
+		 *
+		 * @param index The worker index.
+		 */
+		void worker(const uint64_t index)
+		{
+			t_pCurrentPool = this;
+			t_CurrentWorker = index;
+
+			while (true)
+			{
+				task_type task;
+				if (pop(index, task) || steal(index, task))
+				{
+					m_PendingCount--;
+					task();
+					continue;
+				}
+
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this]
+								 { return m_ShouldStop || m_PendingCount > 0; });
+
+				if (m_ShouldStop && m_PendingCount == 0)
+					return;
+			}
+		}
+
+		/**
+		 * @brief Pop the newest task from a worker's own queue.
+		 *
+		 * @param index The worker index.
+		 * @param task The task to store the popped task.
+		 * @return true if a task was popped.
+		 * @return false if the queue is empty.
+		 */
+		bool pop(const uint64_t index, task_type &task)
+		{
+			auto &queue = *m_Queues[index];
+			std::lock_guard lock(queue.m_Mutex);
+
+			if (queue.m_Tasks.empty())
+				return false;
+
+			task = std::move(queue.m_Tasks.back());
+			queue.m_Tasks.pop_back();
+			return true;
+		}
+
+		/**
+		 * @brief Steal the oldest task from one of the other workers.
+		 *
+		 * @param index The worker index of the thief.
+		 * @param task The task to store the stolen task.
+		 * @return true if a task was stolen.
+		 * @return false if all the other queues are empty.
+		 */
+		bool steal(const uint64_t index, task_type &task)
+		{
+			for (uint64_t i = 1; i < m_Queues.size(); i++)
+			{
+				auto &queue = *m_Queues[(index + i) % m_Queues.size()];
+				std::lock_guard lock(queue.m_Mutex);
+
+				if (!queue.m_Tasks.empty())
+				{
+					task = std::move(queue.m_Tasks.front());
+					queue.m_Tasks.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+} // namespace inventory
@@ -0,0 +1,77 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#pragma once
+
+#include "platform.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+
+namespace inventory
+{
+	/**
+	 * @brief Tick filter class.
+	 * This is used by the queries to check if a component was added or changed after a given tick.
+	 *
+	 * @tparam System The system type.
+	 * @tparam IsAdded Whether to check the added tick instead of the changed tick.
+	 */
+	template <class System, bool IsAdded>
+	class tick_filter final
+	{
+		const System *m_pSystem = nullptr;
+		uint64_t m_Since = 0;
+
+	public:
+		/**
+		 * @brief Default constructor.
+		 */
+		constexpr tick_filter() = default;
+
+		/**
+		 * @brief Construct a new tick filter object.
+		 *
+		 * @param system The system which stores the ticks.
+		 * @param since The tick to compare against. Only the components which were added or changed after this tick will pass.
+		 */
+		constexpr explicit tick_filter(const System &system, const uint64_t since) : m_pSystem(std::addressof(system)), m_Since(since) {}
+
+		/**
+		 * @brief Check if the entity's component passes the filter.
+		 * The entity must be registered to the component.
+		 *
+		 * @tparam Entity The entity type.
+		 * @param ent The entity.
+		 * @return true if the component was added or changed after the tick.
+		 * @return false if the component was not added or changed after the tick.
+		 */
+		template <class Entity>
+		constexpr INV_NODISCARD bool check(const Entity &ent) const
+		{
+			if constexpr (IsAdded)
+				return m_pSystem->added_tick(ent) > m_Since;
+
+			else
+				return m_pSystem->changed_tick(ent) > m_Since;
+		}
+	};
+
+	/**
+	 * @brief Check if an entity passes all the filters of a filter tuple.
+	 *
+	 * @tparam Filters The filter tuple type.
+	 * @tparam Entity The entity type.
+	 * @param filters The filters.
+	 * @param ent The entity.
+	 * @return true if the entity passes all the filters.
+	 * @return false if the entity fails at least one filter.
+	 */
+	template <class Filters, class Entity>
+	constexpr INV_NODISCARD bool check_filters(const Filters &filters, const Entity &ent)
+	{
+		return std::apply([&ent](const auto &...filter)
+						  { return (filter.check(ent) && ...); },
+						  filters);
+	}
+} // namespace inventory
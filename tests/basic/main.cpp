@@ -1,6 +1,20 @@
 // Copyright (c) 2022 Dhiraj Wishal
 
+#ifdef NDEBUG
+#	undef NDEBUG
+#endif
+
+#include <inventory/archetype_registry.hpp>
 #include <inventory/registry.hpp>
+#include <inventory/scheduler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
 
 struct model
 {
@@ -18,11 +32,1583 @@ struct position
 	std::array<float, 3> m_Vector;
 };
 
+struct visible
+{
+};
+
+struct selected
+{
+};
+
+struct health
+{
+	int32_t m_Value = 0;
+};
+
+template <>
+struct inventory::change_tracking_traits<health>
+{
+	static constexpr bool enabled = true;
+};
+
+// Narrow handles, so that the index limit and the generation wrap around can be tested.
+template <>
+struct inventory::entity_handle_traits<uint8_t>
+{
+	using value_type = uint8_t;
+
+	static constexpr uint64_t generation_bits = 2;
+	static constexpr uint64_t index_bits = 6;
+
+	static constexpr uint8_t index_mask = 63;
+	static constexpr uint8_t generation_mask = 3;
+};
+
 using world = std::pair<model, position>;
 using registry = inventory::default_registry<camera, world>;
+using tagged_registry = inventory::default_registry<camera, visible, selected>;
+using tracked_registry = inventory::default_registry<camera, health>;
+
+/**
+ * @brief Test the sparse array removal.
+ * Removing must move the last element into the hole and fix its sparse index, and the stable removal must keep the order of the rest of the elements.
+ */
+void test_sparse_array_remove()
+{
+	inventory::sparse_array<int, uint32_t> array;
+	for (int i = 0; i < 5; i++)
+		assert(array.emplace(i * 10).first == static_cast<uint32_t>(i));
+
+	// Swap-and-pop: the last element (index 4) takes the place of the removed one.
+	array.remove(1);
+	assert(array.size() == 4);
+	assert(!array.contains(1));
+	assert(array.position_of(4) == 1);
+	assert(array.index_of(1) == 4);
+	assert(array[4] == 40);
+	assert(array[0] == 0 && array[2] == 20 && array[3] == 30);
+
+	// Removing the last element does not move anything.
+	array.remove(3);
+	assert(!array.contains(3));
+	assert(array.position_of(2) == 2);
+
+	// The removed indexes are reused.
+	const auto [index, value] = array.emplace(50);
+	assert(index == 3 && value == 50);
+	assert(array.contains(3));
+
+	// Stable removal keeps the order of the rest of the elements.
+	array.stable_remove(0);
+	assert(!array.contains(0));
+
+	const std::vector<int> expected = {40, 20, 50};
+	assert(std::equal(array.begin(), array.end(), expected.begin(), expected.end()));
+
+	for (uint64_t position = 0; position < array.size(); position++)
+		assert(array.position_of(array.index_of(position)) == position);
+
+	// Removing everything releases all the indexes.
+	array.remove(4);
+	array.remove(2);
+	array.remove(3);
+	assert(array.empty());
+	assert(!array.contains(2));
+	assert(array.emplace(0).first == 0);
+}
+
+/**
+ * @brief Test the paged index array.
+ * Pages must only be allocated for the ranges which contain valid indexes, and must be released as soon as the last valid index in them is reset.
+ */
+void test_paged_index_array()
+{
+	inventory::paged_index_array<uint32_t, 4> indexes;
+	assert(indexes.allocated_page_count() == 0);
+	assert(!indexes.contains(0));
+
+	// Positions 3 and 4 straddle the boundary between the first and the second page.
+	indexes.assign(3, 30);
+	indexes.assign(4, 40);
+	assert(indexes.allocated_page_count() == 2);
+	assert(indexes.size() == 5);
+	assert(indexes[3] == 30 && indexes[4] == 40);
+	assert(!indexes.contains(2) && !indexes.contains(5));
+
+	// A far away position only allocates its own page.
+	indexes.assign(17, 170);
+	assert(indexes.allocated_page_count() == 3);
+	assert(indexes.size() == 18);
+	assert(!indexes.contains(8) && !indexes.contains(12));
+
+	// Re-assigning a position does not count it twice, so a single reset releases the page.
+	indexes.assign(17, 171);
+	indexes.reset(17);
+	assert(indexes.allocated_page_count() == 2);
+	assert(!indexes.contains(17));
+
+	// Releasing the first page keeps the second one intact.
+	indexes.reset(3);
+	assert(indexes.allocated_page_count() == 1);
+	assert(indexes.contains(4) && indexes[4] == 40);
+
+	indexes.assign(0, 1);
+	indexes.reset(4);
+	assert(indexes.allocated_page_count() == 1);
+	assert(!indexes.contains(4));
+
+	indexes.shrink_to_fit();
+	assert(indexes.size() == 1);
+	assert(indexes.contains(0) && indexes[0] == 1);
+
+	// Copies own their pages.
+	auto copy = indexes;
+	copy.assign(0, 2);
+	assert(indexes[0] == 1 && copy[0] == 2);
+
+	indexes.clear();
+	assert(indexes.allocated_page_count() == 0);
+	assert(indexes.size() == 0);
+}
+
+/**
+ * @brief Test the bulk entity creation and the bulk registration.
+ * Every callback must be called for all the entities before moving on to the next callback, and every entity must get its own component.
+ */
+void test_bulk_registration()
+{
+	registry entityRegistry;
+	const auto first = entityRegistry.create_entity();
+
+	const auto indexes = entityRegistry.create_entities(10);
+	assert(indexes.size() == 10);
+	assert(entityRegistry.entity_capacity() >= 11);
+
+	for (uint64_t i = 0; i < indexes.size(); i++)
+		assert(indexes[i] == first + i + 1);
+
+	std::vector<std::pair<int, registry::entity_index_type>> calls;
+	const auto firstCallback = entityRegistry.attach_on_register_callback<camera>([&calls](registry &reg, const registry::entity_index_type index)
+																				  {
+																					  assert(!reg.get_entity(index).is_registered_to<camera>());
+																					  calls.emplace_back(0, index); });
+	const auto secondCallback = entityRegistry.attach_on_register_callback<camera>([&calls](registry &, const registry::entity_index_type index)
+																				   { calls.emplace_back(1, index); });
+
+	camera component = {};
+	component.m_View[0] = 1.0f;
+	entityRegistry.register_to_system<camera>(std::span<const registry::entity_index_type>(indexes), component);
+
+	assert(calls.size() == indexes.size() * 2);
+	for (uint64_t i = 0; i < indexes.size(); i++)
+	{
+		assert(calls[i] == std::make_pair(0, indexes[i]));
+		assert(calls[indexes.size() + i] == std::make_pair(1, indexes[i]));
+	}
+
+	assert(entityRegistry.get_system<camera>().size() == indexes.size());
+	assert(!entityRegistry.get_entity(first).is_registered_to<camera>());
+
+	// The components are independent copies of the arguments.
+	entityRegistry.get_component<camera>(indexes[0]).m_View[0] = 2.0f;
+	for (uint64_t i = 1; i < indexes.size(); i++)
+		assert(entityRegistry.get_component<camera>(indexes[i]).m_View[0] == 1.0f);
+
+	entityRegistry.detach_on_register_callback<camera>(firstCallback);
+	entityRegistry.detach_on_register_callback<camera>(secondCallback);
+}
+
+/**
+ * @brief Test trimming the registry.
+ * Trimming must keep the live entities and their components intact, and the entity and component indexes which are handed out afterwards must not collide with
+ * the live ones.
+ */
+void test_trim()
+{
+	registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(100);
+	for (const auto index : indexes)
+		entityRegistry.register_to_system<camera>(index).m_View[0] = static_cast<float>(index);
+
+	// Keep every tenth entity, and the last one so that the trailing indexes are still in use.
+	std::vector<std::pair<registry::entity_index_type, float>> alive;
+	for (const auto index : indexes)
+	{
+		if (index % 10 == 0 || index == indexes.back())
+			alive.emplace_back(index, static_cast<float>(index));
+		else
+			entityRegistry.destroy_entity(index);
+	}
+
+	entityRegistry.trim();
+	assert(entityRegistry.entity_capacity() == alive.size());
+	assert(entityRegistry.capacity<camera>() == alive.size());
+
+	for (const auto &[index, value] : alive)
+		assert(entityRegistry.get_component<camera>(index).m_View[0] == value);
+
+	// Destroy the trailing entity so that the trailing indexes are dropped by the next trim.
+	entityRegistry.destroy_entity(alive.back().first);
+	alive.pop_back();
+	entityRegistry.trim();
+
+	for (uint32_t i = 0; i < 20; i++)
+	{
+		const auto index = entityRegistry.create_entity();
+		assert(std::none_of(alive.begin(), alive.end(), [index](const auto &entry)
+							{ return entry.first == index; }));
+
+		entityRegistry.register_to_system<camera>(index).m_View[0] = -static_cast<float>(i + 1);
+		alive.emplace_back(index, -static_cast<float>(i + 1));
+	}
+
+	for (const auto &[index, value] : alive)
+		assert(entityRegistry.get_component<camera>(index).m_View[0] == value);
+
+	assert(entityRegistry.get_system<camera>().size() == alive.size());
+}
+
+/**
+ * @brief Test the tag components.
+ * Tags must not take an index slot in the entity, and registering and unregistering them must only toggle the entity's bit.
+ */
+void test_tags()
+{
+	static_assert(inventory::get_storage_component_count<camera, visible, selected>() == 1);
+	static_assert(sizeof(tagged_registry::entity_type) == sizeof(inventory::entity<inventory::default_index_type, camera>));
+
+	tagged_registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(6);
+	for (const auto index : indexes)
+	{
+		entityRegistry.register_to_system<camera>(index);
+
+		if (index % 2 == 0)
+			entityRegistry.register_to_system<visible>(index);
+	}
+
+	// Registering a tag twice does not count it twice.
+	entityRegistry.register_to_system<visible>(0);
+	entityRegistry.register_to_system<selected>(2);
+	assert(entityRegistry.get_system<visible>().size() == 3);
+	assert(entityRegistry.get_system<selected>().size() == 1);
+
+	std::vector<tagged_registry::entity_index_type> visibleEntities;
+	for (auto [index, component] : entityRegistry.each<camera, visible>())
+		visibleEntities.emplace_back(index);
+
+	std::sort(visibleEntities.begin(), visibleEntities.end());
+	assert((visibleEntities == std::vector<tagged_registry::entity_index_type>{0, 2, 4}));
+
+	uint64_t count = 0;
+	for ([[maybe_unused]] const auto &entity : entityRegistry.query<visible, selected>())
+		count++;
+
+	assert(count == 1);
+
+	entityRegistry.unregister_from_system<visible>(2);
+	assert(!entityRegistry.get_entity(2).is_registered_to<visible>());
+	assert(entityRegistry.get_entity(2).is_registered_to<selected>());
+	assert(entityRegistry.get_system<visible>().size() == 2);
+
+	count = 0;
+	for ([[maybe_unused]] const auto &entity : entityRegistry.query<visible, selected>())
+		count++;
+
+	assert(count == 0);
+
+	// Destroying an entity unregisters its tags.
+	entityRegistry.destroy_entity(4);
+	assert(entityRegistry.get_system<visible>().size() == 1);
+
+	count = 0;
+	for ([[maybe_unused]] const auto &entity : entityRegistry.query<visible>())
+		count++;
+
+	assert(count == 1);
+}
+
+/**
+ * @brief Test the owner tracking of the systems.
+ * The owners must stay parallel to the components after a swap-and-pop removal.
+ */
+void test_owners()
+{
+	registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(8))
+		entityRegistry.register_to_system<camera>(index).m_View[0] = static_cast<float>(index);
+
+	entityRegistry.unregister_from_system<camera>(1);
+	entityRegistry.destroy_entity(4);
+
+	const auto &system = entityRegistry.get_system<camera>();
+	const auto owners = system.entities();
+	assert(owners.size() == 6 && system.size() == 6);
+
+	// The last components were moved into the holes.
+	assert(system.owner_of(1) == 7);
+	assert(system.owner_of(4) == 6);
+
+	uint64_t position = 0;
+	for (auto [owner, component] : system.each())
+	{
+		assert(owner == owners[position]);
+		assert(owner == system.owner_of(position));
+		assert(component.m_View[0] == static_cast<float>(owner));
+		assert(&component == &entityRegistry.get_component<camera>(owner));
+		position++;
+	}
+
+	assert(position == owners.size());
+}
+
+/**
+ * @brief Collect the entities which are registered to all the given components by scanning every entity.
+ *
+ * @tparam Components The components.
+ * @tparam Registry The registry type.
+ * @param entityRegistry The registry.
+ * @param count The number of entities which were created.
+ * @return std::vector<typename Registry::entity_index_type> The sorted entity indexes.
+ */
+template <class... Components, class Registry>
+std::vector<typename Registry::entity_index_type> full_scan(const Registry &entityRegistry, const uint32_t count)
+{
+	std::vector<typename Registry::entity_index_type> indexes;
+	for (uint32_t index = 0; index < count; index++)
+	{
+		if ((entityRegistry.get_entity(index).template is_registered_to<Components>() && ...))
+			indexes.emplace_back(index);
+	}
+
+	return indexes;
+}
+
+/**
+ * @brief Collect the entities yielded by a component query.
+ *
+ * @tparam Components The components.
+ * @tparam Registry The registry type.
+ * @param entityRegistry The registry.
+ * @return std::vector<typename Registry::entity_index_type> The sorted entity indexes.
+ */
+template <class... Components, class Registry>
+std::vector<typename Registry::entity_index_type> query_scan(Registry &entityRegistry)
+{
+	std::vector<typename Registry::entity_index_type> indexes;
+	for (const auto &result : entityRegistry.template each<Components...>())
+		indexes.emplace_back(std::get<0>(result));
+
+	std::sort(indexes.begin(), indexes.end());
+	return indexes;
+}
+
+/**
+ * @brief Test that the queries which are driven by the smallest system yield the same entities as a full scan.
+ * The smallest system changes from the cameras to the worlds half way through.
+ */
+void test_smallest_driver()
+{
+	registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(100);
+	for (const auto index : indexes)
+	{
+		if (index % 10 == 0)
+			entityRegistry.register_to_system<camera>(index);
+
+		if (index % 3 == 0)
+			entityRegistry.register_to_system<world>(index);
+	}
+
+	assert(entityRegistry.get_system<camera>().size() < entityRegistry.get_system<world>().size());
+	assert((query_scan<camera, world>(entityRegistry) == full_scan<camera, world>(entityRegistry, 100)));
+	assert((query_scan<world, camera>(entityRegistry) == full_scan<camera, world>(entityRegistry, 100)));
+
+	for (const auto index : indexes)
+	{
+		if (index % 10 != 0 && index % 2 == 0)
+			entityRegistry.register_to_system<camera>(index);
+	}
+
+	assert(entityRegistry.get_system<camera>().size() > entityRegistry.get_system<world>().size());
+	assert((query_scan<camera, world>(entityRegistry) == full_scan<camera, world>(entityRegistry, 100)));
+	assert((query_scan<world, camera>(entityRegistry) == full_scan<camera, world>(entityRegistry, 100)));
+
+	uint64_t count = 0;
+	for ([[maybe_unused]] const auto &entity : entityRegistry.query<camera, world>())
+		count++;
+
+	assert((count == full_scan<camera, world>(entityRegistry, 100).size()));
+}
+
+/**
+ * @brief Test the exclude and optional query filters.
+ * Excluded components must skip the entities which have them, and optional components must not filter, but yield null when they are missing.
+ */
+void test_query_filters()
+{
+	registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(10))
+	{
+		entityRegistry.register_to_system<camera>(index);
+
+		if (index % 2 == 0)
+			entityRegistry.register_to_system<world>(index);
+	}
+
+	std::vector<registry::entity_index_type> indexes;
+	for (const auto &[index, component] : entityRegistry.each<camera, inventory::exclude<world>>())
+		indexes.emplace_back(index);
+
+	std::sort(indexes.begin(), indexes.end());
+	assert((indexes == std::vector<registry::entity_index_type>{1, 3, 5, 7, 9}));
+
+	uint64_t count = 0;
+	for (const auto &entity : entityRegistry.query<camera, inventory::exclude<world>>())
+	{
+		assert(!entity.is_registered_to<world>());
+		count++;
+	}
+
+	assert(count == 5);
+
+	count = 0;
+	for (const auto &[index, component, pWorld] : entityRegistry.each<camera, inventory::optional<world>>())
+	{
+		assert((pWorld != nullptr) == (index % 2 == 0));
+		assert(pWorld == entityRegistry.try_get_component<world>(index));
+		count++;
+	}
+
+	assert(count == 10);
+
+	count = 0;
+	for (const auto &entity : entityRegistry.query<camera, inventory::optional<world>>())
+	{
+		if (entity.is_registered_to<world>())
+			assert(entityRegistry.try_get_component<world>(entity) != nullptr);
+		else
+			assert(entityRegistry.try_get_component<world>(entity) == nullptr);
+
+		count++;
+	}
+
+	assert(count == 10);
+
+	const auto &constRegistry = entityRegistry;
+	assert(constRegistry.try_get_component<world>(1) == nullptr);
+	assert(constRegistry.try_get_component<world>(2) == &constRegistry.get_component<world>(2));
+}
+
+/**
+ * @brief Test the component queries.
+ * Every matching entity must be yielded once along with its components, and optional tags must be yielded as booleans.
+ */
+void test_component_query()
+{
+	tagged_registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(6))
+	{
+		entityRegistry.register_to_system<camera>(index).m_View[0] = static_cast<float>(index);
+
+		if (index % 3 == 0)
+			entityRegistry.register_to_system<visible>(index);
+	}
+
+	uint64_t count = 0;
+	for (auto [index, component, isVisible] : entityRegistry.each<camera, inventory::optional<visible>>())
+	{
+		static_assert(std::is_same_v<decltype(isVisible), bool>);
+		assert(component.m_View[0] == static_cast<float>(index));
+		assert(isVisible == (index % 3 == 0));
+		count++;
+	}
+
+	assert(count == 6);
+
+	const auto &constRegistry = entityRegistry;
+	count = 0;
+	for (auto [index, component, isVisible, isSelected] : constRegistry.each<camera, inventory::optional<visible, selected>>())
+	{
+		static_assert(std::is_same_v<decltype(component), const camera &>);
+		assert(isVisible == (index % 3 == 0));
+		assert(!isSelected);
+		count++;
+	}
+
+	assert(count == 6);
+}
+
+/**
+ * @brief Test the parallel for each functions.
+ * Every matching entity must be processed exactly once, even when the requested chunk size is not cache aligned.
+ */
+void test_parallel_for_each()
+{
+#ifdef INV_USE_UNSEQ
+	constexpr auto policy = std::execution::par;
+
+#else
+	constexpr auto policy = inventory::execution::seq;
+
+#endif
+
+	tagged_registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(200))
+	{
+		entityRegistry.register_to_system<camera>(index);
+
+		if (index % 3 == 0)
+			entityRegistry.register_to_system<visible>(index);
+	}
+
+	std::atomic<uint64_t> count = 0;
+	entityRegistry.query<camera, visible>().for_each(policy, [&count](auto &)
+													 { count++; },
+													 3);
+	assert(count == 67);
+
+	entityRegistry.each<camera, visible>().for_each(policy, [](auto index, camera &component)
+													{ component.m_View[0] += static_cast<float>(index + 1); },
+													5);
+
+	entityRegistry.get_system<camera>().for_each(policy, [](camera &component)
+												 { component.m_Proj[0] += 1.0f; },
+												 7);
+
+	for (auto [index, component, isVisible] : entityRegistry.each<camera, inventory::optional<visible>>())
+	{
+		assert(component.m_View[0] == (isVisible ? static_cast<float>(index + 1) : 0.0f));
+		assert(component.m_Proj[0] == 1.0f);
+	}
+
+	registry groupRegistry;
+	for (const auto index : groupRegistry.create_entities(50))
+	{
+		groupRegistry.register_to_system<camera>(index);
+		groupRegistry.register_to_system<world>(index);
+	}
+
+	groupRegistry.group<camera, world>().for_each(policy, [](camera &component, world &)
+												   { component.m_View[1] += 1.0f; },
+												   3);
+
+	for (auto [index, component] : groupRegistry.each<camera>())
+		assert(component.m_View[1] == 1.0f);
+}
+
+/**
+ * @brief Test the cached queries.
+ * The cached entity list must follow the registrations, unregistrations and destroyed entities, and must not be used after the query is uncached.
+ */
+void test_cached_queries()
+{
+	registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(20);
+	for (const auto index : indexes)
+	{
+		if (index % 2 == 0)
+			entityRegistry.register_to_system<camera>(index);
+	}
+
+	entityRegistry.cache_query<camera, world>();
+	assert((entityRegistry.is_query_cached<camera, world>()));
+	assert(!entityRegistry.is_query_cached<camera>());
+
+	for (const auto index : indexes)
+	{
+		if (index % 3 == 0)
+			entityRegistry.register_to_system<world>(index);
+	}
+
+	assert((query_scan<camera, world>(entityRegistry) == full_scan<camera, world>(entityRegistry, 20)));
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{0, 6, 12, 18}));
+
+	entityRegistry.unregister_from_system<camera>(6);
+	entityRegistry.destroy_entity(12);
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{0, 18}));
+
+	// The destroyed entity's index is reused by the next entity.
+	const auto index = entityRegistry.create_entity();
+	assert(index == 12);
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{0, 18}));
+
+	entityRegistry.register_to_system<world>(index);
+	entityRegistry.register_to_system<camera>(index);
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{0, 12, 18}));
+
+	entityRegistry.uncache_query<camera, world>();
+	assert(!(entityRegistry.is_query_cached<camera, world>()));
+
+	entityRegistry.unregister_from_system<world>(0);
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{12, 18}));
+
+	// Caching a query with existing entities collects them.
+	entityRegistry.cache_query<camera, world>();
+	assert((query_scan<camera, world>(entityRegistry) == std::vector<registry::entity_index_type>{12, 18}));
+}
+
+/**
+ * @brief Check the bit set operations across the word boundaries.
+ * This is evaluated at compile time (which uses the scalar path) and at runtime (which uses the SIMD path if it's available).
+ *
+ * @tparam Bits The number of bits.
+ * @return true if all the checks passed.
+ * @return false if any of the checks failed.
+ */
+template <uint64_t Bits>
+constexpr bool check_bit_set()
+{
+	using bit_set = inventory::bit_set<Bits>;
+	bool result = true;
+
+	bit_set set;
+	for (const auto pos : {uint64_t(0), uint64_t(63), uint64_t(64), uint64_t(127), uint64_t(128), Bits - 1})
+		set.toggle_true(pos);
+
+	result &= set.count() == 6;
+	result &= set.find_first() == 0;
+	result &= set.find_next(0) == 63;
+	result &= set.find_next(63) == 64;
+	result &= set.find_next(64) == 127;
+	result &= set.find_next(127) == 128;
+	result &= set.find_next(128) == Bits - 1;
+	result &= set.find_next(Bits - 1) == bit_set::npos;
+
+	// Only the bits in the last word are compared by the scalar tail.
+	bit_set last;
+	last.toggle_true(Bits - 1);
+	result &= set.contains(last) && set.intersects(last);
+
+	bit_set other;
+	other.toggle_true(65);
+	result &= !set.contains(other) && !set.intersects(other);
+
+	other.toggle_true(128);
+	result &= !set.contains(other) && set.intersects(other);
+
+	other.toggle_false(65);
+	result &= set.contains(other) && set != other;
+
+	bit_set copy = set;
+	result &= copy == set && copy.contains(set);
+
+	copy.toggle(64, false);
+	result &= copy != set && set.contains(copy) && !copy.contains(set);
+	result &= copy < set;
+
+	result &= bit_set().none() && !bit_set().intersects(set) && set.contains(bit_set());
+	return result;
+}
+
+/**
+ * @brief Test the bit set with masks spanning multiple words.
+ */
+void test_bit_set()
+{
+	static_assert(check_bit_set<130>());
+	static_assert(check_bit_set<300>());
+	static_assert(check_bit_set<512>());
+
+	assert(check_bit_set<130>());
+	assert(check_bit_set<300>());
+	assert(check_bit_set<512>());
+}
+
+/**
+ * @brief Test the mask column.
+ * Scans must yield the positions of the masks which contain the required bits and none of the excluded bits, in order.
+ */
+void test_mask_column()
+{
+	using bit_set = inventory::bit_set<3>;
+
+	bit_set first;
+	first.toggle_true(0);
+
+	bit_set both = first;
+	both.toggle_true(1);
+
+	bit_set second;
+	second.toggle_true(1);
+
+	inventory::mask_column<bit_set, std::allocator<uint64_t>, 4> masks;
+	for (uint64_t i = 0; i < 10; i++)
+		masks.push_back(i % 3 == 0 ? both : (i % 3 == 1 ? first : second));
+
+	assert(masks.size() == 10);
+
+	const auto scan = [&masks](const bit_set &required, const bit_set &excluded)
+	{
+		std::vector<uint64_t> positions;
+		std::array<uint64_t, 3> batch = {};
+
+		uint64_t position = 0;
+		while (const auto count = masks.scan(position, masks.size(), required, excluded, batch))
+			positions.insert(positions.end(), batch.begin(), batch.begin() + count);
+
+		return positions;
+	};
+
+	assert((scan(first, bit_set()) == std::vector<uint64_t>{0, 1, 3, 4, 6, 7, 9}));
+	assert((scan(first, second) == std::vector<uint64_t>{1, 4, 7}));
+	assert((scan(both, bit_set()) == std::vector<uint64_t>{0, 3, 6, 9}));
+
+	masks.assign(3, second);
+	assert((scan(both, bit_set()) == std::vector<uint64_t>{0, 6, 9}));
+
+	// The last mask is moved into the removed position.
+	masks.remove(0);
+	assert(masks.size() == 9);
+	assert((scan(both, bit_set()) == std::vector<uint64_t>{0, 6}));
+}
+
+/**
+ * @brief Collect the entities yielded by a query into a sorted list of entity addresses.
+ *
+ * @tparam Query The query type.
+ * @param query The query.
+ * @return std::vector<const void *> The entity addresses.
+ */
+template <class Query>
+std::vector<const void *> collect_entities(Query &&query)
+{
+	std::vector<const void *> entities;
+	for (const auto &entity : query)
+		entities.emplace_back(&entity);
+
+	std::sort(entities.begin(), entities.end());
+	return entities;
+}
+
+/**
+ * @brief Collect the entities which have a given mask by scanning every entity, into a sorted list of entity addresses.
+ *
+ * @tparam Registry The registry type.
+ * @tparam Function The function type.
+ * @param entityRegistry The registry.
+ * @param alive The alive entity indexes.
+ * @param function The function which checks an entity.
+ * @return std::vector<const void *> The entity addresses.
+ */
+template <class Registry, class Function>
+std::vector<const void *> collect_entities(const Registry &entityRegistry, const std::vector<typename Registry::entity_index_type> &alive, Function &&function)
+{
+	std::vector<const void *> entities;
+	for (const auto index : alive)
+	{
+		const auto &entity = entityRegistry.get_entity(index);
+		if (function(entity))
+			entities.emplace_back(&entity);
+	}
+
+	std::sort(entities.begin(), entities.end());
+	return entities;
+}
+
+/**
+ * @brief Test the mask queries.
+ * Queries which only contain tags must scan the mask column and yield the same entities as a full scan.
+ */
+void test_mask_query()
+{
+	tagged_registry entityRegistry;
+	const auto alive = entityRegistry.create_entities(200);
+	for (const auto index : alive)
+	{
+		if (index % 2 == 0)
+			entityRegistry.register_to_system<visible>(index);
+
+		if (index % 5 == 0)
+			entityRegistry.register_to_system<selected>(index);
+	}
+
+	const auto isVisible = [](const auto &entity)
+	{ return entity.template is_registered_to<visible>(); };
+	const auto isVisibleOnly = [](const auto &entity)
+	{ return entity.template is_registered_to<visible>() && !entity.template is_registered_to<selected>(); };
+
+	assert(collect_entities(entityRegistry.query<visible>()) == collect_entities(entityRegistry, alive, isVisible));
+	assert((collect_entities(entityRegistry.query<visible, inventory::exclude<selected>>()) == collect_entities(entityRegistry, alive, isVisibleOnly)));
+
+	const auto &constRegistry = entityRegistry;
+	assert(collect_entities(constRegistry.query<visible>()).size() == 100);
+}
+
+/**
+ * @brief Test the block summaries of the mask column.
+ * Registering, unregistering and destroying entities in random order must keep the summaries up to date, so that the scans which skip blocks using them still
+ * yield the same entities as a full scan.
+ */
+void test_mask_summaries()
+{
+	// Removing an entity moves the last mask into an earlier block, whose summary does not contain its bits yet.
+	{
+		tagged_registry entityRegistry;
+		const auto indexes = entityRegistry.create_entities(inventory::default_mask_block_size * 2 + 2);
+		entityRegistry.register_to_system<visible>(indexes.back());
+
+		entityRegistry.destroy_entity(indexes.front());
+		assert(collect_entities(entityRegistry.query<visible>()).size() == 1);
+
+		// Clearing a bit recomputes the summary, which must keep the bits of the moved mask.
+		entityRegistry.register_to_system<visible>(indexes[1]);
+		entityRegistry.unregister_from_system<visible>(indexes[1]);
+		assert(collect_entities(entityRegistry.query<visible>()).size() == 1);
+
+		entityRegistry.unregister_from_system<visible>(indexes.back());
+		assert(collect_entities(entityRegistry.query<visible>()).empty());
+
+		// Dropping the last block keeps the summaries of the rest.
+		entityRegistry.register_to_system<selected>(indexes[indexes.size() - 2]);
+		entityRegistry.destroy_entity(indexes[2]);
+		assert(collect_entities(entityRegistry.query<selected>()).size() == 1);
+	}
+
+	tagged_registry entityRegistry;
+	std::vector<tagged_registry::entity_index_type> alive = entityRegistry.create_entities(500);
+	std::mt19937 generator(42);
+
+	const auto isVisible = [](const auto &entity)
+	{ return entity.template is_registered_to<visible>(); };
+	const auto isSelected = [](const auto &entity)
+	{ return entity.template is_registered_to<selected>(); };
+	const auto isBoth = [](const auto &entity)
+	{ return entity.template is_registered_to<visible>() && entity.template is_registered_to<selected>(); };
+
+	// The tags are kept sparse, so that most of the blocks are skipped by the scans.
+	for (uint32_t round = 0; round < 100; round++)
+	{
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			const auto index = alive[generator() % alive.size()];
+			switch (generator() % 8)
+			{
+			case 0:
+				entityRegistry.register_to_system<visible>(index);
+				break;
+
+			case 1:
+				entityRegistry.register_to_system<selected>(index);
+				break;
+
+			case 2:
+				entityRegistry.unregister_from_system<visible>(index);
+				break;
+
+			case 3:
+				entityRegistry.unregister_from_system<selected>(index);
+				break;
+
+			case 4:
+			case 5:
+				entityRegistry.destroy_entity(index);
+				alive.erase(std::find(alive.begin(), alive.end(), index));
+				break;
+
+			default:
+				alive.emplace_back(entityRegistry.create_entity());
+				break;
+			}
+		}
+
+		assert(collect_entities(entityRegistry.query<visible>()) == collect_entities(entityRegistry, alive, isVisible));
+		assert(collect_entities(entityRegistry.query<selected>()) == collect_entities(entityRegistry, alive, isSelected));
+		assert((collect_entities(entityRegistry.query<visible, selected>()) == collect_entities(entityRegistry, alive, isBoth)));
+	}
+}
+
+/**
+ * @brief Test the archetype registry.
+ * Moving entities between tables (when registering, unregistering and destroying) must keep the components of every entity, including the entity which is moved
+ * into the removed row, and the queries with the exclude and optional filters must yield the same entities as a full scan.
+ */
+void test_archetype_registry()
+{
+	using archetype_registry = inventory::archetype_registry<camera, position, visible>;
+
+	/**
+	 * @brief Expected state of an entity.
+	 */
+	struct expected_entity final
+	{
+		std::optional<float> m_Camera;
+		std::optional<float> m_Position;
+		bool m_IsVisible = false;
+	};
+
+	archetype_registry entityRegistry;
+	std::map<archetype_registry::entity_index_type, expected_entity> expected;
+	for (const auto index : entityRegistry.create_entities(100))
+		expected[index];
+
+	std::mt19937 generator(7);
+	for (uint32_t round = 0; round < 50; round++)
+	{
+		for (uint32_t i = 0; i < 40; i++)
+		{
+			const auto index = std::next(expected.begin(), generator() % expected.size())->first;
+			auto &state = expected[index];
+			const auto value = static_cast<float>(generator() % 1000);
+
+			switch (generator() % 8)
+			{
+			case 0:
+				entityRegistry.register_to_system<camera>(index).m_View[0] = value;
+				state.m_Camera = value;
+				break;
+
+			case 1:
+				entityRegistry.register_to_system<position>(index).m_Vector[0] = value;
+				state.m_Position = value;
+				break;
+
+			case 2:
+				entityRegistry.register_to_system<visible>(index);
+				state.m_IsVisible = true;
+				break;
+
+			case 3:
+				entityRegistry.unregister_from_system<camera>(index);
+				state.m_Camera.reset();
+				break;
+
+			case 4:
+				entityRegistry.unregister_from_system<position>(index);
+				state.m_Position.reset();
+				break;
+
+			case 5:
+				entityRegistry.unregister_from_system<visible>(index);
+				state.m_IsVisible = false;
+				break;
+
+			case 6:
+				entityRegistry.destroy_entity(index);
+				expected.erase(index);
+				expected[entityRegistry.create_entity()];
+				break;
+
+			default:
+				expected[entityRegistry.create_entity()];
+				break;
+			}
+		}
+
+		assert(entityRegistry.size() == expected.size());
+		for (const auto &[index, state] : expected)
+		{
+			assert(entityRegistry.is_registered_to<camera>(index) == state.m_Camera.has_value());
+			assert(entityRegistry.is_registered_to<position>(index) == state.m_Position.has_value());
+			assert(entityRegistry.is_registered_to<visible>(index) == state.m_IsVisible);
+
+			if (state.m_Camera)
+				assert(entityRegistry.get_component<camera>(index).m_View[0] == *state.m_Camera);
+
+			if (state.m_Position)
+				assert(entityRegistry.get_component<position>(index).m_Vector[0] == *state.m_Position);
+		}
+
+		std::map<archetype_registry::entity_index_type, float> cameras;
+		for (auto [index, component] : entityRegistry.each<camera>())
+			cameras[index] = component.m_View[0];
+
+		std::map<archetype_registry::entity_index_type, float> expectedCameras;
+		for (const auto &[index, state] : expected)
+		{
+			if (state.m_Camera)
+				expectedCameras[index] = *state.m_Camera;
+		}
+
+		assert(cameras == expectedCameras);
+
+		uint64_t count = 0;
+		for (auto [index, component] : std::as_const(entityRegistry).each<camera, visible, inventory::exclude<position>>())
+		{
+			const auto &state = expected.at(index);
+			assert(state.m_Camera && state.m_IsVisible && !state.m_Position);
+			assert(component.m_View[0] == *state.m_Camera);
+			count++;
+		}
+
+		assert(count == static_cast<uint64_t>(std::count_if(expected.begin(), expected.end(), [](const auto &entry)
+															 { return entry.second.m_Camera && entry.second.m_IsVisible && !entry.second.m_Position; })));
+
+		count = 0;
+		for (auto [index, component, pPosition] : entityRegistry.each<camera, inventory::optional<position>>())
+		{
+			const auto &state = expected.at(index);
+			assert(state.m_Camera);
+			assert((pPosition != nullptr) == state.m_Position.has_value());
+
+			if (pPosition)
+				assert(pPosition->m_Vector[0] == *state.m_Position);
+
+			count++;
+		}
+
+		assert(count == expectedCameras.size());
+
+		count = 0;
+		for (auto [index, component, isVisible] : entityRegistry.each<camera, inventory::optional<visible>>())
+		{
+			static_assert(std::is_same_v<decltype(isVisible), bool>);
+			assert(isVisible == expected.at(index).m_IsVisible);
+			count++;
+		}
+
+		assert(count == expectedCameras.size());
+
+		count = 0;
+		for (const auto &[entities, cameraColumn, isVisible] : entityRegistry.each<camera, inventory::optional<visible>>().chunks(16))
+		{
+			assert(entities.size() == cameraColumn.size());
+			for (const auto index : entities)
+				assert(isVisible == expected.at(index).m_IsVisible);
+
+			count += entities.size();
+		}
+
+		assert(count == expectedCameras.size());
+	}
+}
+
+/**
+ * @brief Component which throws from its constructor on request.
+ */
+struct throwing_component
+{
+	int32_t m_Value = 0;
+
+	explicit throwing_component(const int32_t value) : m_Value(value)
+	{
+		if (value < 0)
+			throw std::invalid_argument("Negative values are not allowed!");
+	}
+};
+
+/**
+ * @brief Test the archetype table transitions.
+ * A query must stay valid when new tables are created after it, and a component constructor which throws must leave the entity in its old table with all of its
+ * components.
+ */
+void test_archetype_transitions()
+{
+	using archetype_registry = inventory::archetype_registry<camera, position, visible, model, throwing_component>;
+
+	archetype_registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(64);
+	for (uint32_t i = 0; i < 2; i++)
+		entityRegistry.register_to_system<camera>(indexes[i]).m_View[0] = static_cast<float>(i + 1);
+
+	const auto query = entityRegistry.each<camera>();
+
+	// Create every other table, so that the table container has to grow many times.
+	for (uint32_t i = 2; i < indexes.size(); i++)
+	{
+		if (i & 1)
+			[[maybe_unused]] decltype(auto) component = entityRegistry.register_to_system<position>(indexes[i]);
+
+		if (i & 2)
+			[[maybe_unused]] decltype(auto) component = entityRegistry.register_to_system<visible>(indexes[i]);
+
+		if (i & 4)
+			[[maybe_unused]] decltype(auto) component = entityRegistry.register_to_system<model>(indexes[i]);
+
+		if (i & 8)
+			[[maybe_unused]] decltype(auto) component = entityRegistry.register_to_system<throwing_component>(indexes[i], 1);
+	}
+
+	assert(entityRegistry.table_count() > 8);
+
+	float sum = 0.0f;
+	for (auto [index, component] : query)
+	{
+		assert(index == indexes[0] || index == indexes[1]);
+		sum += component.m_View[0];
+	}
+
+	assert(sum == 3.0f);
+
+	const auto index = indexes.front();
+	entityRegistry.register_to_system<position>(index).m_Vector[0] = 5.0f;
+
+	const auto tableCount = entityRegistry.table_count();
+	bool hasThrown = false;
+	try
+	{
+		[[maybe_unused]] decltype(auto) component = entityRegistry.register_to_system<throwing_component>(index, -1);
+	}
+	catch (const std::invalid_argument &)
+	{
+		hasThrown = true;
+	}
+
+	assert(hasThrown);
+	assert(!entityRegistry.is_registered_to<throwing_component>(index));
+	assert(entityRegistry.get_component<camera>(index).m_View[0] == 1.0f);
+	assert(entityRegistry.get_component<position>(index).m_Vector[0] == 5.0f);
+	assert(entityRegistry.table_count() >= tableCount);
+
+	// The table of the failed transition must still be consistent.
+	assert(entityRegistry.register_to_system<throwing_component>(index, 2).m_Value == 2);
+	assert(entityRegistry.get_component<camera>(index).m_View[0] == 1.0f);
+
+	uint64_t count = 0;
+	for (auto [entity, component, value] : entityRegistry.each<camera, throwing_component>())
+	{
+		assert(entity == index && value.m_Value == 2);
+		count++;
+	}
+
+	assert(count == 1);
+}
+
+/**
+ * @brief Test the compact entity layout.
+ * Registering and unregistering components in any order must keep the index slots of the other attached components, and queries must yield the same entities as
+ * the dense layout.
+ */
+void test_compact_registry()
+{
+	using compact_registry = inventory::compact_registry<camera, visible, position, model>;
+	static_assert(std::is_same_v<compact_registry::entity_type, inventory::compact_entity<inventory::default_index_type, std::allocator<inventory::default_index_type>, camera, visible, position, model>>);
+	static_assert(std::is_same_v<tagged_registry::entity_type, inventory::entity<inventory::default_index_type, camera, visible, selected>>);
+
+	compact_registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(30);
+	for (const auto index : indexes)
+	{
+		if (index % 2 == 0)
+			entityRegistry.register_to_system<model>(index).m_Matrix[0] = static_cast<float>(index);
+
+		if (index % 3 == 0)
+			entityRegistry.register_to_system<camera>(index).m_View[0] = static_cast<float>(index);
+
+		if (index % 5 == 0)
+			entityRegistry.register_to_system<visible>(index);
+
+		entityRegistry.register_to_system<position>(index).m_Vector[0] = static_cast<float>(index);
+	}
+
+	// Removing the first component shifts the slots of the components after it.
+	for (const auto index : indexes)
+	{
+		if (index % 4 == 0 && index % 3 == 0)
+			entityRegistry.unregister_from_system<camera>(index);
+	}
+
+	for (const auto index : indexes)
+	{
+		const auto hasCamera = index % 3 == 0 && index % 4 != 0;
+		assert(entityRegistry.get_entity(index).is_registered_to<camera>() == hasCamera);
+		assert(entityRegistry.get_component<position>(index).m_Vector[0] == static_cast<float>(index));
+
+		if (hasCamera)
+			assert(entityRegistry.get_component<camera>(index).m_View[0] == static_cast<float>(index));
+
+		if (index % 2 == 0)
+			assert(entityRegistry.get_component<model>(index).m_Matrix[0] == static_cast<float>(index));
+	}
+
+	uint64_t count = 0;
+	for (auto [index, component, pModel] : entityRegistry.each<position, visible, inventory::optional<model>>())
+	{
+		assert(index % 5 == 0);
+		assert(component.m_Vector[0] == static_cast<float>(index));
+		assert((pModel != nullptr) == (index % 2 == 0));
+		count++;
+	}
+
+	assert(count == 6);
+}
+
+/**
+ * @brief Test the contiguous batches.
+ * The batch sizes must be rounded up to whole cache lines, every batch except the last must be full, and the batches must cover every component exactly once and in
+ * order. Group and archetype batches must keep their spans parallel, and archetype batches must never cross two tables.
+ */
+void test_chunks()
+{
+	static_assert(inventory::get_aligned_chunk_size<position>(10) == 16);
+	static_assert(inventory::get_aligned_chunk_size<position>(17) == 32);
+	static_assert(inventory::get_aligned_chunk_size<position>(0) == 16);
+	static_assert(inventory::get_aligned_chunk_size<camera>(3) == 3);
+	static_assert(inventory::get_aligned_chunk_size<char>(1) == 64);
+	static_assert(inventory::get_aligned_chunk_size<camera, position>(3) == 16);
+
+	registry entityRegistry;
+	const auto indexes = entityRegistry.create_entities(100);
+	for (const auto index : indexes)
+	{
+		entityRegistry.register_to_system<camera>(index).m_View[0] = static_cast<float>(index);
+
+		if (index % 3 != 0)
+			entityRegistry.register_to_system<world>(index).second.m_Vector[0] = static_cast<float>(index);
+	}
+
+	// System batches.
+	{
+		const auto &system = std::as_const(entityRegistry).get_system<camera>();
+		const camera *pNext = &*system.begin();
+		uint64_t count = 0;
+
+		for (std::span<const camera> batch : system.chunks(7))
+		{
+			assert(batch.data() == pNext);
+			assert(batch.size() == 7 || count + batch.size() == system.size());
+
+			pNext = batch.data() + batch.size();
+			count += batch.size();
+		}
+
+		assert(count == system.size());
+
+		uint64_t batchCount = 0;
+		for (std::span<world> batch : entityRegistry.get_system<world>().chunks(10))
+		{
+			assert(batch.size() == 16 || batchCount * 16 + batch.size() == entityRegistry.get_system<world>().size());
+			batchCount++;
+		}
+
+		assert(batchCount == (entityRegistry.get_system<world>().size() + 15) / 16);
+	}
+
+	// Group batches.
+	{
+		auto group = entityRegistry.group<camera, world>();
+		uint64_t count = 0;
+
+		for (auto [entities, cameras, worlds] : group.chunks(3))
+		{
+			assert(entities.size() == 16 || count + entities.size() == group.size());
+			assert(cameras.size() == entities.size() && worlds.size() == entities.size());
+
+			for (uint64_t i = 0; i < entities.size(); i++)
+			{
+				assert(&cameras[i] == &entityRegistry.get_component<camera>(entities[i]));
+				assert(&worlds[i] == &entityRegistry.get_component<world>(entities[i]));
+			}
+
+			count += entities.size();
+		}
+
+		assert(count == group.size());
+		assert(count == 66);
+	}
+
+	// Archetype batches.
+	{
+		inventory::archetype_registry<camera, position> archetypeRegistry;
+		for (const auto index : archetypeRegistry.create_entities(100))
+		{
+			archetypeRegistry.register_to_system<position>(index).m_Vector[0] = static_cast<float>(index);
+
+			if (index % 4 == 0)
+				archetypeRegistry.register_to_system<camera>(index);
+		}
+
+		std::vector<uint32_t> seen;
+		for (auto [entities, positions, pCameras] : archetypeRegistry.each<position, inventory::optional<camera>>().chunks(5))
+		{
+			assert(!entities.empty() && entities.size() <= 16);
+			assert(positions.size() == entities.size());
+			assert(pCameras.empty() || pCameras.size() == entities.size());
+
+			for (uint64_t i = 0; i < entities.size(); i++)
+			{
+				// Every entity of a batch must be in the same table.
+				assert(archetypeRegistry.is_registered_to<camera>(entities[i]) == !pCameras.empty());
+				assert(&positions[i] == &archetypeRegistry.get_component<position>(entities[i]));
+				seen.emplace_back(entities[i]);
+			}
+		}
+
+		std::sort(seen.begin(), seen.end());
+		assert(seen.size() == 100);
+		assert(std::adjacent_find(seen.begin(), seen.end()) == seen.end());
+	}
+}
+
+/**
+ * @brief Test the change detection.
+ * Reading a tracked component must not mark it as changed, even through a mutable reference. Only patch() and mark_changed() must update the changed tick.
+ */
+void test_change_detection()
+{
+	tracked_registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(10))
+		entityRegistry.register_to_system<health>(index);
+
+	const auto countChanged = [&entityRegistry](const uint64_t since)
+	{
+		uint64_t count = 0;
+		for ([[maybe_unused]] auto [index, component] : std::as_const(entityRegistry).each<health, inventory::changed<health>>(since))
+			count++;
+
+		return count;
+	};
+
+	assert(countChanged(0) == 10);
+
+	const auto lastTick = entityRegistry.advance_tick();
+	assert(countChanged(lastTick) == 0);
+
+	uint64_t sum = 0;
+	for (auto [index, component] : entityRegistry.each<health>())
+		sum += component.m_Value + entityRegistry.get_component<health>(index).m_Value;
+
+	assert(sum == 0);
+	assert(entityRegistry.try_get_component<health>(0) != nullptr);
+	assert(countChanged(lastTick) == 0);
+
+	entityRegistry.patch<health>(3, [](health &component)
+								 { component.m_Value = 5; });
+	entityRegistry.get_component<health>(5).m_Value = 7;
+	entityRegistry.mark_changed<health>(5);
+
+	std::vector<uint64_t> changed;
+	for (auto [index, component] : entityRegistry.each<health, inventory::changed<health>>(lastTick))
+		changed.emplace_back(index);
+
+	assert((changed == std::vector<uint64_t>{3, 5}) || (changed == std::vector<uint64_t>{5, 3}));
+	assert(entityRegistry.get_component<health>(3).m_Value == 5);
+
+	uint64_t added = 0;
+	for ([[maybe_unused]] auto [index, component] : std::as_const(entityRegistry).each<health, inventory::added<health>>(lastTick))
+		added++;
+
+	assert(added == 0);
+}
+
+/**
+ * @brief Test the entity handles.
+ * A handle must become invalid once its entity is destroyed, even if the index is reused. The default handles must cover the whole index range, while entities past
+ * the index mask of a narrower handle layout must still be created, but requesting their handle must throw.
+ */
+void test_entity_handles()
+{
+	using small_registry = inventory::registry<uint16_t, uint16_t, camera>;
+	using traits = inventory::entity_handle_traits<uint16_t>;
+
+	static_assert(std::is_same_v<traits::value_type, uint32_t> && traits::generation_bits == 16 && traits::index_mask == std::numeric_limits<uint16_t>::max());
+	static_assert(inventory::entity_handle_traits<uint32_t>::generation_bits == 32 && inventory::entity_handle_traits<uint64_t>::index_bits == 48);
+	static_assert(!std::is_constructible_v<small_registry::handle_type, uint16_t, uint16_t>);
+
+	small_registry entityRegistry;
+	const auto first = entityRegistry.create_entity();
+	const auto handle = entityRegistry.get_handle(first);
+	assert(entityRegistry.valid(handle));
+	assert(!entityRegistry.valid(small_registry::handle_type()));
+
+	entityRegistry.destroy_entity(first);
+	assert(!entityRegistry.valid(handle));
+
+	const auto reused = entityRegistry.create_entity();
+	assert(reused == first);
+	assert(!entityRegistry.valid(handle));
+	assert(entityRegistry.valid(entityRegistry.get_handle(reused)));
+	assert(entityRegistry.get_handle(reused).generation() == 1);
+
+	const auto indexes = entityRegistry.create_entities(traits::index_mask - 1);
+	assert(indexes.back() == traits::index_mask - 1);
+	assert(entityRegistry.get_handle(indexes.back()).index() == indexes.back());
+
+	using narrow_registry = inventory::registry<uint8_t, uint8_t, camera>;
+	using narrow_traits = inventory::entity_handle_traits<uint8_t>;
+
+	narrow_registry narrowRegistry;
+	const auto narrowIndexes = narrowRegistry.create_entities(narrow_traits::index_mask + 10);
+	assert(narrowIndexes.back() > narrow_traits::index_mask);
+	assert(narrowRegistry.get_handle(narrow_traits::index_mask - 1).index() == narrow_traits::index_mask - 1);
+
+	bool hasThrown = false;
+	try
+	{
+		[[maybe_unused]] const auto invalid = narrowRegistry.get_handle(narrow_traits::index_mask);
+	}
+	catch (const inventory::entity_handle_error &)
+	{
+		hasThrown = true;
+	}
+
+	assert(hasThrown);
+
+	narrowRegistry.register_to_system<camera>(narrowIndexes.back()).m_View[0] = 1.0f;
+	assert(narrowRegistry.get_component<camera>(narrowIndexes.back()).m_View[0] == 1.0f);
+
+	// The generation wraps around after 2^generation_bits reuses, and the old handle aliases the new entity.
+	const auto narrowHandle = narrowRegistry.get_handle(0);
+	for (uint64_t i = 0; i <= narrow_traits::generation_mask; i++)
+	{
+		narrowRegistry.destroy_entity(0);
+		assert(narrowRegistry.valid(narrowHandle) == (i == narrow_traits::generation_mask));
+		assert(narrowRegistry.create_entity() == 0);
+	}
+
+	assert(narrowRegistry.valid(narrowHandle));
+}
+
+/**
+ * @brief Test the thread pool.
+ * Every submitted task must be executed before the pool is destroyed, including the tasks which are submitted from the workers.
+ */
+void test_thread_pool()
+{
+	std::atomic<uint64_t> count = 0;
+	{
+		inventory::thread_pool pool(4);
+		for (uint64_t i = 0; i < 1000; i++)
+		{
+			pool.submit([&pool, &count]
+						{
+							assert(pool.is_worker_thread());
+							pool.submit([&count]
+										{ count++; });
+							count++; });
+		}
+
+		assert(!pool.is_worker_thread());
+	}
+
+	assert(count == 2000);
+}
+
+/**
+ * @brief Test the scheduler.
+ * Conflicting tasks must depend on each other and run in the order they were added, exclusive tasks must never run alongside another task, and the first
+ * exception must be rethrown once the run is finished.
+ */
+void test_scheduler()
+{
+	registry entityRegistry;
+	for (const auto index : entityRegistry.create_entities(100))
+		entityRegistry.register_to_system<camera>(index);
+
+	// Build the dependency graph.
+	{
+		inventory::scheduler<registry> scheduler(4);
+		const auto readCamera = scheduler.add_task<inventory::reads<camera>>([](auto &) {});
+		const auto readCameraAgain = scheduler.add_task<inventory::reads<camera>>([](auto &) {});
+		const auto writeCamera = scheduler.add_task<inventory::writes<camera>>([](auto &) {});
+		const auto writeWorld = scheduler.add_task<inventory::reads<camera>, inventory::writes<world>>([](auto &) {});
+		const auto exclusive = scheduler.add_task([](auto &) {});
+
+		assert(!scheduler.depends_on(readCameraAgain, readCamera));
+		assert(scheduler.depends_on(writeCamera, readCamera));
+		assert(scheduler.depends_on(writeCamera, readCameraAgain));
+		assert(scheduler.depends_on(writeWorld, writeCamera));
+		assert(!scheduler.depends_on(writeWorld, readCamera));
+
+		for (uint64_t i = 0; i < exclusive; i++)
+			assert(scheduler.depends_on(exclusive, i));
+	}
+
+	// Conflicting tasks must run in order, and exclusive tasks must run alone.
+	{
+		std::atomic<uint64_t> step = 0;
+		std::atomic<uint64_t> running = 0;
+
+		inventory::scheduler<registry> scheduler(4);
+		scheduler.add_task<inventory::writes<camera>>([&step, &running](auto &reg)
+													  {
+														  static_assert(!std::is_const_v<std::remove_reference_t<decltype(reg)>>);
+														  running++;
+														  for (auto [index, component] : reg.template get_system<camera>().each())
+															  component.m_View[0] = 1.0f;
+
+														  assert(step.exchange(1) == 0);
+														  running--; });
+
+		for (uint64_t i = 0; i < 8; i++)
+		{
+			scheduler.add_task<inventory::reads<camera>>([&step, &running](auto &reg)
+														 {
+															 static_assert(std::is_const_v<std::remove_reference_t<decltype(reg)>>);
+															 running++;
+															 assert(step >= 1);
+															 for (auto [index, component] : reg.template get_system<camera>().each())
+																 assert(component.m_View[0] == 1.0f);
+
+															 running--; });
+		}
+
+		scheduler.add_task([&step, &running](auto &reg)
+						   {
+							   assert(running.exchange(1) == 0);
+							   step = 2;
+							   reg.destroy_entity(reg.create_entity());
+							   running = 0; });
+
+		scheduler.add_task<inventory::reads<camera>>([&step](auto &)
+													 { assert(step == 2); });
+
+		for (uint64_t i = 0; i < 10; i++)
+		{
+			step = 0;
+			scheduler.run(entityRegistry);
+			assert(step == 2);
+		}
+	}
+
+	// The first exception must be rethrown, and the dependents of the failed task must be skipped.
+	{
+		std::atomic<bool> hasRun = false;
+
+		inventory::scheduler<registry> scheduler(4);
+		scheduler.add_task<inventory::writes<camera>>([](auto &)
+													  { throw std::runtime_error("failed"); });
+		scheduler.add_task<inventory::reads<camera>>([&hasRun](auto &)
+													 { hasRun = true; });
+
+		bool hasThrown = false;
+		try
+		{
+			scheduler.run(entityRegistry);
+		}
+		catch (const std::runtime_error &)
+		{
+			hasThrown = true;
+		}
+
+		assert(hasThrown);
+		assert(!hasRun);
+
+		// The scheduler must still be usable after a failed run.
+		scheduler.clear();
+		scheduler.add_task<inventory::reads<camera>>([&hasRun](auto &)
+													 { hasRun = true; });
+		scheduler.run(entityRegistry);
+		assert(hasRun);
+	}
+}
 
 int main()
 {
+	test_sparse_array_remove();
+	test_paged_index_array();
+	test_bulk_registration();
+	test_trim();
+	test_tags();
+	test_owners();
+	test_smallest_driver();
+	test_query_filters();
+	test_component_query();
+	test_parallel_for_each();
+	test_cached_queries();
+	test_bit_set();
+	test_mask_column();
+	test_mask_query();
+	test_mask_summaries();
+	test_change_detection();
+	test_entity_handles();
+	test_archetype_registry();
+	test_archetype_transitions();
+	test_compact_registry();
+	test_chunks();
+	test_thread_pool();
+	test_scheduler();
+
 	registry entityRegistry;
 	const auto index = entityRegistry.attach_on_register_callback<camera>([](registry& reg, const registry::entity_index_type index) {});
 
@@ -37,5 +1623,13 @@ int main()
 		[[maybe_unused]] auto& cw = entityRegistry.get_component<camera>(entity);
 	}
 
+	for (auto [owner, component] : entityRegistry.get_system<camera>().each())
+	{
+		assert(owner == ent);
+		assert(&component == &entityRegistry.get_component<camera>(owner));
+
+		[[maybe_unused]] auto& cw = entityRegistry.get_component<world>(owner);
+	}
+
 	entityRegistry.detach_on_register_callback<camera>(index);
 }
\ No newline at end of file
@@ -0,0 +1,330 @@
+// Copyright (c) 2022 Dhiraj Wishal
+
+#ifdef NDEBUG
+#	undef NDEBUG
+#endif
+
+#include <inventory/registry.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+
+struct position
+{
+	std::array<float, 3> m_Vector;
+};
+
+template <>
+struct inventory::storage_traits<position>
+{
+	using policy = inventory::chunked_storage<16>;
+};
+
+struct transform
+{
+	float m_X;
+	float m_Y;
+	uint32_t m_ID;
+};
+
+template <>
+struct inventory::storage_traits<transform>
+{
+	using policy = inventory::soa_storage<&transform::m_X, &transform::m_Y, &transform::m_ID>;
+};
+
+struct alignas(8) particle
+{
+	float m_Position[3];
+};
+
+template <>
+struct inventory::storage_traits<particle>
+{
+	using policy = inventory::aligned_storage<>;
+};
+
+using registry = inventory::default_registry<position, transform>;
+
+/**
+ * @brief Memory resource which records the last allocation request.
+ */
+class recording_resource final : public std::pmr::memory_resource
+{
+public:
+	std::size_t m_LastBytes = 0;
+	std::size_t m_LastAlignment = 0;
+	std::size_t m_LastDeallocatedBytes = 0;
+
+private:
+	void *do_allocate(const std::size_t bytes, const std::size_t alignment) override
+	{
+		m_LastBytes = bytes;
+		m_LastAlignment = alignment;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) override
+	{
+		m_LastDeallocatedBytes = bytes;
+		std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+/**
+ * @brief Test the chunked storage policy.
+ * Components must keep their addresses while the storage grows, and removing a component must keep the rest of the components intact.
+ */
+void test_chunked_storage()
+{
+	registry entityRegistry;
+
+	const auto first = entityRegistry.create_entity();
+	const auto pFirst = &entityRegistry.register_to_system<position>(first, position{{0.0f, 0.0f, 0.0f}});
+
+	for (uint32_t i = 1; i < 100; i++)
+		entityRegistry.register_to_system<position>(entityRegistry.create_entity(), position{{static_cast<float>(i), 0.0f, 0.0f}});
+
+	assert(&entityRegistry.get_component<position>(first) == pFirst);
+
+	for (uint32_t i = 1; i < 100; i += 3)
+		entityRegistry.unregister_from_system<position>(i);
+
+	uint64_t count = 0;
+	for (auto [owner, component] : entityRegistry.get_system<position>().each())
+	{
+		assert(owner % 3 != 1);
+		assert(component.m_Vector[0] == static_cast<float>(owner));
+		count++;
+	}
+
+	assert(count == 100 - 33);
+	assert(entityRegistry.get_system<position>().capacity() % 16 == 0);
+}
+
+/**
+ * @brief Test the structure of arrays vector.
+ * The proxies must read and write the columns, and assigning a proxy to another must copy all the stored members.
+ */
+void test_soa_vector()
+{
+	inventory::soa_vector<transform, std::allocator<transform>, &transform::m_X, &transform::m_Y> vector;
+	vector.emplace_back(transform{1.0f, 2.0f, 7});
+	vector.emplace_back(transform{3.0f, 4.0f, 8});
+
+	// Members which are not listed are not stored.
+	const transform first = vector[0];
+	assert(first.m_X == 1.0f && first.m_Y == 2.0f && first.m_ID == 0);
+
+	vector[0].get<&transform::m_X>() = 5.0f;
+	assert(vector.column<&transform::m_X>()[0] == 5.0f);
+	assert(vector.column<1>()[1] == 4.0f);
+
+	vector[0] = vector[1];
+	assert(vector[0].get<&transform::m_X>() == 3.0f && vector[0].get<&transform::m_Y>() == 4.0f);
+
+	vector[1] = transform{6.0f, 7.0f, 0};
+	assert(vector.column<&transform::m_Y>()[1] == 7.0f);
+
+	vector.erase(vector.begin());
+	assert(vector.size() == 1);
+	assert(vector.column<&transform::m_X>().size() == 1 && vector.column<&transform::m_Y>().size() == 1);
+	assert(vector[0].get<&transform::m_X>() == 6.0f);
+}
+
+/**
+ * @brief Test the structure of arrays storage policy.
+ * The columns must stay parallel to the owners of the system, including after a swap-and-pop removal.
+ */
+void test_soa_storage()
+{
+	registry entityRegistry;
+	for (uint32_t i = 0; i < 10; i++)
+		entityRegistry.register_to_system<transform>(entityRegistry.create_entity(), transform{static_cast<float>(i), -static_cast<float>(i), i});
+
+	entityRegistry.get_component<transform>(3).get<&transform::m_Y>() = 30.0f;
+	assert(entityRegistry.get_component<transform>(3).get<&transform::m_Y>() == 30.0f);
+
+	entityRegistry.unregister_from_system<transform>(2);
+	entityRegistry.unregister_from_system<transform>(5);
+
+	auto &system = entityRegistry.get_system<transform>();
+	const auto xs = system.column<&transform::m_X>();
+	const auto ids = system.column<&transform::m_ID>();
+	assert(xs.size() == 8 && ids.size() == 8);
+
+	for (uint64_t position = 0; position < system.size(); position++)
+	{
+		const auto owner = system.owner_of(position);
+		assert(owner != 2 && owner != 5);
+		assert(ids[position] == owner);
+		assert(xs[position] == static_cast<float>(owner));
+	}
+
+	const transform component = entityRegistry.get_component<transform>(3);
+	assert(component.m_X == 3.0f && component.m_Y == 30.0f && component.m_ID == 3);
+}
+
+/**
+ * @brief Test the dense index set used by the query cache.
+ * Removing an index must move the last index into its place, and copying a set into another memory resource must keep every index and its position.
+ */
+void test_dense_index_set()
+{
+	using index_set = inventory::dense_index_set<uint32_t, std::pmr::polymorphic_allocator<uint32_t>>;
+
+	std::pmr::monotonic_buffer_resource firstResource;
+	std::pmr::monotonic_buffer_resource secondResource;
+
+	index_set indexes{std::pmr::polymorphic_allocator<uint32_t>(&firstResource)};
+	for (uint32_t i = 0; i < 5000; i += 5)
+		assert(indexes.insert(i));
+
+	assert(!indexes.insert(0));
+	assert(indexes.size() == 1000);
+
+	indexes.remove(0);
+	indexes.remove(7);
+	assert(indexes.size() == 999);
+	assert(!indexes.contains(0));
+	assert(*indexes.begin() == 4995);
+
+	for (uint32_t i = 5; i < 2500; i += 5)
+		indexes.remove(i);
+
+	const index_set copy{indexes, std::pmr::polymorphic_allocator<uint32_t>(&secondResource)};
+	assert(copy.get_allocator().resource() == &secondResource);
+	assert(copy.size() == 500);
+
+	for (uint32_t i = 0; i < 5000; i += 5)
+		assert(copy.contains(i) == (i >= 2500));
+
+	auto other = copy;
+	for (const auto index : copy)
+		other.remove(index);
+
+	assert(other.empty());
+	assert(copy.size() == 500);
+}
+
+/**
+ * @brief Test assigning registries which use polymorphic allocators.
+ * The allocators are not propagated, so moving between two different memory resources must move the components one by one, and the target must keep its resource.
+ */
+void test_pmr_assignment()
+{
+	using velocity = std::array<float, 2>;
+	using pmr_registry = inventory::pmr_registry<position, velocity>;
+
+	std::pmr::monotonic_buffer_resource firstResource;
+	std::pmr::monotonic_buffer_resource secondResource;
+
+	pmr_registry source{std::pmr::polymorphic_allocator<std::byte>(&firstResource)};
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		const auto index = source.create_entity();
+		source.register_to_system<position>(index, position{{static_cast<float>(i), 0.0f, 0.0f}});
+		source.register_to_system<velocity>(index, velocity{static_cast<float>(i), 1.0f});
+	}
+
+	pmr_registry target{std::pmr::polymorphic_allocator<std::byte>(&secondResource)};
+	target = std::move(source);
+	assert(target.get_allocator().resource() == &secondResource);
+
+	pmr_registry copy{std::pmr::polymorphic_allocator<std::byte>(&firstResource)};
+	copy = target;
+
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		assert(target.get_component<position>(i).m_Vector[0] == static_cast<float>(i));
+		assert(copy.get_component<velocity>(i)[0] == static_cast<float>(i));
+	}
+
+	// Moving between registries which share a resource takes over the storage.
+	pmr_registry other{std::pmr::polymorphic_allocator<std::byte>(&firstResource)};
+	const auto pFirst = &copy.get_component<position>(0);
+	other = std::move(copy);
+	assert(&other.get_component<position>(0) == pFirst);
+}
+
+/**
+ * @brief Test the aligned allocator.
+ * Every allocation must start on the alignment boundary and must be padded to a whole number of alignment blocks, and deallocating must give the same size back
+ * to the upstream allocator.
+ */
+void test_aligned_allocator()
+{
+	recording_resource resource;
+	inventory::aligned_allocator<float, 64, std::pmr::polymorphic_allocator<float>> allocator{std::pmr::polymorphic_allocator<float>(&resource)};
+
+	const auto checkAllocation = [&resource, &allocator](const std::size_t count, const std::size_t expectedBytes)
+	{
+		const auto pointer = allocator.allocate(count);
+		assert(reinterpret_cast<std::uintptr_t>(pointer) % 64 == 0);
+		assert(resource.m_LastBytes == expectedBytes);
+		assert(resource.m_LastAlignment == 64);
+
+		allocator.deallocate(pointer, count);
+		assert(resource.m_LastDeallocatedBytes == expectedBytes);
+	};
+
+	checkAllocation(1, 64);
+	checkAllocation(16, 64);
+	checkAllocation(17, 128);
+	checkAllocation(100, 448);
+
+	// Rebinding keeps the upstream allocator.
+	const inventory::aligned_allocator<double, 64, std::pmr::polymorphic_allocator<double>> rebound(allocator);
+	assert(rebound == allocator);
+	assert(rebound.upstream().resource() == &resource);
+
+	std::vector<float, inventory::aligned_allocator<float, 32>> vector;
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		vector.emplace_back(static_cast<float>(i));
+		assert(reinterpret_cast<std::uintptr_t>(vector.data()) % 32 == 0);
+	}
+}
+
+/**
+ * @brief Test the aligned storage policy.
+ * The component array must stay aligned while it grows, and every batch returned by chunks() must start on a cache line boundary.
+ */
+void test_aligned_storage()
+{
+	inventory::default_registry<particle> entityRegistry;
+	for (const auto index : entityRegistry.create_entities(500))
+	{
+		entityRegistry.register_to_system<particle>(index).m_Position[0] = static_cast<float>(index);
+		assert(reinterpret_cast<std::uintptr_t>(&*entityRegistry.get_system<particle>().begin()) % inventory::default_cache_line_size == 0);
+	}
+
+	// Twelve particles of 16 bytes span exactly three cache lines.
+	static_assert(sizeof(particle) == 16);
+	static_assert(inventory::get_aligned_chunk_size<particle>(10) == 12);
+
+	uint64_t count = 0;
+	for (std::span<particle> batch : entityRegistry.get_system<particle>().chunks(10))
+	{
+		assert(reinterpret_cast<std::uintptr_t>(batch.data()) % inventory::default_cache_line_size == 0);
+		assert(batch.size() == 12 || count + batch.size() == 500);
+		count += batch.size();
+	}
+
+	assert(count == 500);
+	assert(entityRegistry.get_component<particle>(499).m_Position[0] == 499.0f);
+}
+
+int main()
+{
+	test_chunked_storage();
+	test_pmr_assignment();
+	test_soa_vector();
+	test_soa_storage();
+	test_dense_index_set();
+	test_aligned_allocator();
+	test_aligned_storage();
+}